@@ -1,8 +1,34 @@
 #include <iostream>
 #include <cstring>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <string>
+#include <algorithm>
+#include <numeric>
 #include <vector>
+#include <atomic>
+#include <memory>
 #include <random>
 #include <ctime>
+#include <chrono>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <sys/prctl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sched.h>
+#include <pthread.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace std;
 
@@ -25,12 +51,6 @@ Color framebuffer[FRAMEBUFFER_SIZE];
 Color aliveColor = { 255, 255, 255 };
 Color deadColor = { 0, 0, 0 };
 
-void setPixel(int x, int y, Color color) {
-    if (x >= 0 && x < RENDER_WIDTH && y >= 0 && y < RENDER_HEIGHT) {
-        framebuffer[y * RENDER_WIDTH + x] = color;
-    }
-}
-
 void renderBuffer(SDL_Renderer* renderer) {
     // Crear una textura
     SDL_Texture* texture = SDL_CreateTexture(
@@ -65,81 +85,855 @@ void renderBuffer(SDL_Renderer* renderer) {
     SDL_RenderPresent(renderer);
 }
 
-int countAliveNeighbors(int x, int y) {
-    int aliveNeighbors = 0;
+// Estado de la simulación: cada célula ocupa 1 bit dentro de palabras de 64 bits.
+// El bit i de la palabra k de una fila corresponde a la columna x = 64 * k + i.
+// El framebuffer de colores solo se usa para mostrar el resultado.
+//
+// Cada fila lleva una palabra de halo a la izquierda y otra a la derecha, y el
+// tablero tiene una fila de halo arriba y otra abajo. El halo se llena una vez
+// por generación (fillLifeHalo) según el tipo de borde, de modo que los kernels
+// leen siempre a sus vecinos sin revisar si están dentro del tablero.
+//
+// Las palabras útiles de cada fila empiezan en una línea de caché (64 bytes):
+// la palabra de halo izquierda es la última de la línea anterior.
+const int LIFE_WORD_BITS = 64;
+const int LIFE_CACHE_LINE = 64;
+const int LIFE_LINE_WORDS = LIFE_CACHE_LINE / sizeof(uint64_t);
+const int LIFE_ROW_OFFSET = LIFE_LINE_WORDS;
 
-    for (int i = -1; i <= 1; i++) {
-        for (int j = -1; j <= 1; j++) {
-            if (i == 0 && j == 0) {
-                continue;
-            }
+// Límites del tamaño del universo (el patrón más grande, la gun, mide 36x11)
+const int LIFE_MIN_DIMENSION = 40;
+const int LIFE_MAX_DIMENSION = 65536;
+
+// Tamaño del universo en células. Por omisión coincide con la ventana de
+// RENDER_WIDTH x RENDER_HEIGHT, pero puede ser mucho mayor (--size); el
+// framebuffer solo muestra la región que empieza en (lifeViewX, lifeViewY).
+int universeWidth = RENDER_WIDTH;
+int universeHeight = RENDER_HEIGHT;
+int lifeViewX = 0;
+int lifeViewY = 0;
+
+// Geometría del tablero de bits, calculada por resizeGameOfLife()
+int lifeWordsPerRow = 0;
+int lifeStride = 0;
+size_t lifeWords = 0;
+
+// Máscara de las columnas válidas en la última palabra de cada fila
+uint64_t lifeLastWordMask = ~0ULL;
+
+// Comportamiento en los bordes del tablero
+enum LifeBoundary {
+    LIFE_BOUNDARY_DEAD,  // Fuera del tablero todo está muerto
+    LIFE_BOUNDARY_WRAP   // Los bordes opuestos se tocan (toro)
+};
+
+LifeBoundary lifeBoundary = LIFE_BOUNDARY_DEAD;
+
+// Generación actual y siguiente. Se intercambian por puntero al terminar cada
+// generación, sin copiar el tablero.
+uint64_t* lifeCells = nullptr;
+uint64_t* lifeNextCells = nullptr;
+
+// Teselas de 64x64 células: 64 filas de una palabra. Solo se recalculan las
+// teselas que cambiaron en la generación anterior y sus vecinas; una tesela sin
+// cambios tiene el mismo contenido en los dos buffers, así que saltarla deja la
+// siguiente generación correcta sin copiar nada.
+const int LIFE_TILE_ROWS = 64;
+
+int lifeTileCols = 0;
+int lifeTileRows = 0;
+vector<uint8_t> lifeTileChanged;      // Cambió en la última generación
+vector<uint8_t> lifeNextTileChanged;  // Se llena mientras se calcula la siguiente
+vector<uint8_t> lifeTileActive;       // Se recalcula en esta generación
+size_t lifeActiveTiles = 0;
+
+// Región del framebuffer que cambió en la última generación (w = 0 si ninguna)
+SDL_Rect lifeDirtyRect = { 0, 0, 0, 0 };
+
+// Generaciones calculadas desde initializeGameOfLife()
+uint64_t lifeGeneration = 0;
+
+// Estadísticas de la última actualización (ver getLifeStats). Los kernels cuentan
+// nacimientos y muertes mientras calculan y la población se ajusta con ellos;
+// solo se recuenta el tablero cuando se escribió en bloque.
+uint64_t lifePopulation = 0;
+bool lifePopulationKnown = false;
+uint64_t lifeBirths = 0;
+uint64_t lifeDeaths = 0;
+
+// Se activa cada vez que se escribe el tablero de bits desde fuera del motor;
+// los motores con su propia representación (HashLife) lo usan para volver a importarlo
+bool lifeGridEdited = true;
+
+// Obliga a recalcular y volver a pintar todo el universo (tras escribir el tablero en bloque)
+void markAllLifeTilesChanged() {
+    fill(lifeTileChanged.begin(), lifeTileChanged.end(), 1);
+    lifeGridEdited = true;
+    lifePopulationKnown = false;
+}
+
+#include "gameofLifeMemory.h"
+
+// Cambia el tamaño del universo y reserva sus buffers (todas las células quedan muertas)
+void resizeGameOfLife(int width, int height) {
+    // universeWidth/universeHeight pueden cambiar antes de reservar (por ejemplo
+    // al leer --size), así que se compara con el tamaño realmente reservado
+    static int allocatedWidth = 0;
+    static int allocatedHeight = 0;
+    if (lifeCells && width == allocatedWidth && height == allocatedHeight) {
+        return;
+    }
+    allocatedWidth = width;
+    allocatedHeight = height;
+
+    freeLifeBuffer(lifeCells, lifeWords);
+    freeLifeBuffer(lifeNextCells, lifeWords);
+
+    universeWidth = width;
+    universeHeight = height;
+    lifeWordsPerRow = (width + LIFE_WORD_BITS - 1) / LIFE_WORD_BITS;
+    lifeStride = (LIFE_ROW_OFFSET + lifeWordsPerRow + 1 + LIFE_LINE_WORDS - 1) / LIFE_LINE_WORDS * LIFE_LINE_WORDS;
+    lifeWords = (size_t)lifeStride * (height + 2);
+    lifeLastWordMask = (width % LIFE_WORD_BITS == 0) ? ~0ULL : (1ULL << (width % LIFE_WORD_BITS)) - 1;
+
+    lifeTileCols = lifeWordsPerRow;
+    lifeTileRows = (height + LIFE_TILE_ROWS - 1) / LIFE_TILE_ROWS;
+
+    lifeCells = allocateLifeBuffer(lifeWords);
+    lifeNextCells = allocateLifeBuffer(lifeWords);
+    clearLifeBuffer(lifeCells);
+    clearLifeBuffer(lifeNextCells);
+    lifeTileChanged.assign((size_t)lifeTileCols * lifeTileRows, 1);
+    lifeNextTileChanged.assign((size_t)lifeTileCols * lifeTileRows, 0);
+    lifeTileActive.assign((size_t)lifeTileCols * lifeTileRows, 0);
+
+    // La vista queda centrada cuando el universo es más grande que la ventana
+    lifeViewX = max(0, (width - RENDER_WIDTH) / 2);
+    lifeViewY = max(0, (height - RENDER_HEIGHT) / 2);
+}
+
+// Primera palabra útil de la fila y (de -1 a universeHeight, contando el halo)
+inline uint64_t* lifeRow(uint64_t* cells, int y) {
+    return cells + (size_t)(y + 1) * lifeStride + LIFE_ROW_OFFSET;
+}
+
+bool getCell(int x, int y) {
+    if (x < 0 || x >= universeWidth || y < 0 || y >= universeHeight) {
+        return false;
+    }
+    uint64_t word = lifeRow(lifeCells, y)[x / LIFE_WORD_BITS];
+    return (word >> (x % LIFE_WORD_BITS)) & 1;
+}
+
+void setCell(int x, int y, bool alive) {
+    if (x >= 0 && x < universeWidth && y >= 0 && y < universeHeight) {
+        uint64_t& word = lifeRow(lifeCells, y)[x / LIFE_WORD_BITS];
+        uint64_t bit = 1ULL << (x % LIFE_WORD_BITS);
+        if (((word & bit) != 0) != alive) {
+            lifePopulation += alive ? 1 : -1;
+        }
+        word = alive ? (word | bit) : (word & ~bit);
+        lifeTileChanged[(size_t)(y / LIFE_TILE_ROWS) * lifeTileCols + x / LIFE_WORD_BITS] = 1;
+        lifeGridEdited = true;
+    }
+}
+
+// Cambia la célula (x, y) del universo según su color y, si está a la vista, también su píxel
+void setPixel(int x, int y, Color color) {
+    setCell(x, y, color.r == aliveColor.r && color.g == aliveColor.g && color.b == aliveColor.b);
+
+    int pixelX = x - lifeViewX;
+    int pixelY = y - lifeViewY;
+    if (pixelX >= 0 && pixelX < RENDER_WIDTH && pixelY >= 0 && pixelY < RENDER_HEIGHT) {
+        framebuffer[pixelY * RENDER_WIDTH + pixelX] = color;
+    }
+}
+
+// Fuerza el inlining de los kernels aun compilando sin optimizaciones, para que
+// las versiones vectoriales hereden el conjunto de instrucciones de quien las llama.
+// Como nunca se llaman como funciones separadas, el aviso de ABI por pasar
+// vectores AVX entre funciones no aplica.
+#define LIFE_INLINE inline __attribute__((always_inline))
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+// Calcula la siguiente generación de 64 células a la vez.
+// Cada argumento es una palabra de vecinos ya desplazada: (a) fila de arriba,
+// (b) fila actual y (c) fila de abajo, con sus versiones hacia el oeste (W) y el este (E).
+// Los vecinos se suman con sumadores completos bit a bit, de modo que cada bit
+// del resultado cuenta los vecinos de su propia célula.
+// W puede ser uint64_t o un vector de palabras (ver gameofLifeSimd.h).
+template <typename W>
+LIFE_INLINE W lifeWord(const W& aW, const W& a, const W& aE, const W& bW, const W& b, const W& bE,
+                       const W& cW, const W& c, const W& cE) {
+    // Suma por fila: bit de peso 1 y acarreo de peso 2
+    W aSum = aW ^ a ^ aE;
+    W aCarry = (aW & a) | (aE & (aW ^ a));
+    W cSum = cW ^ c ^ cE;
+    W cCarry = (cW & c) | (cE & (cW ^ c));
+    W bSum = bW ^ bE;
+    W bCarry = bW & bE;
+
+    // Bit de peso 1 del total y su acarreo
+    W ones = aSum ^ cSum ^ bSum;
+    W onesCarry = (aSum & cSum) | (bSum & (aSum ^ cSum));
+
+    // Bits de peso 2 y 4 (el peso 8 solo aparece con 8 vecinos y deja twos = 0)
+    W carrySum = aCarry ^ cCarry ^ bCarry;
+    W carryCarry = (aCarry & cCarry) | (bCarry & (aCarry ^ cCarry));
+    W twos = carrySum ^ onesCarry;
+    W fours = carryCarry ^ (carrySum & onesCarry);
+
+    // Vive con 3 vecinos, o con 2 si ya estaba viva
+    return twos & ~fours & (ones | b);
+}
+
+// Reglas "Life-like": el bit n de cada máscara indica que una célula nace
+// (Birth) o sobrevive (Survive) con n vecinos vivos
+const int LIFE_CONWAY_BIRTH = 1 << 3;
+const int LIFE_CONWAY_SURVIVE = (1 << 2) | (1 << 3);
+
+// Siguiente generación de 64 células con una regla fija en compilación. La suma
+// de vecinos es la misma de lifeWord() pero completa (de 0 a 8); el ciclo sobre
+// las cantidades depende solo de constantes, así que el compilador lo deja en
+// unas pocas operaciones de bits sin saltos. Conway usa directamente lifeWord().
+template <int Birth, int Survive, typename W>
+LIFE_INLINE W lifeRuleWord(const W& aW, const W& a, const W& aE, const W& bW, const W& b, const W& bE,
+                           const W& cW, const W& c, const W& cE) {
+    if (Birth == LIFE_CONWAY_BIRTH && Survive == LIFE_CONWAY_SURVIVE) {
+        return lifeWord<W>(aW, a, aE, bW, b, bE, cW, c, cE);
+    }
+
+    W aSum = aW ^ a ^ aE;
+    W aCarry = (aW & a) | (aE & (aW ^ a));
+    W cSum = cW ^ c ^ cE;
+    W cCarry = (cW & c) | (cE & (cW ^ c));
+    W bSum = bW ^ bE;
+    W bCarry = bW & bE;
+
+    W ones = aSum ^ cSum ^ bSum;
+    W onesCarry = (aSum & cSum) | (bSum & (aSum ^ cSum));
+
+    W carrySum = aCarry ^ cCarry ^ bCarry;
+    W carryCarry = (aCarry & cCarry) | (bCarry & (aCarry ^ cCarry));
+    W twos = carrySum ^ onesCarry;
+    W fours = carryCarry ^ (carrySum & onesCarry);
+    W eights = carryCarry & carrySum & onesCarry;
+
+    W born = b ^ b;
+    W survive = b ^ b;
+    for (int n = 0; n <= 8; n++) {
+        if (!(((Birth | Survive) >> n) & 1)) {
+            continue;
+        }
+        W match = ((n & 1) ? ones : ~ones) & ((n & 2) ? twos : ~twos) &
+                  ((n & 4) ? fours : ~fours) & ((n & 8) ? eights : ~eights);
+        if ((Birth >> n) & 1) {
+            born |= match;
+        }
+        if ((Survive >> n) & 1) {
+            survive |= match;
+        }
+    }
+    return (born & ~b) | (survive & b);
+}
+
+// Calcula la palabra k de una fila. Las palabras k - 1 y k + 1 siempre existen
+// gracias al halo, así que no hay casos especiales en los bordes.
+template <int Birth = LIFE_CONWAY_BIRTH, int Survive = LIFE_CONWAY_SURVIVE>
+LIFE_INLINE uint64_t lifeRowWord(const uint64_t* above, const uint64_t* row, const uint64_t* below, int k) {
+    return lifeRuleWord<Birth, Survive, uint64_t>((above[k] << 1) | (above[k - 1] >> 63), above[k], (above[k] >> 1) | (above[k + 1] << 63),
+                                                  (row[k] << 1) | (row[k - 1] >> 63), row[k], (row[k] >> 1) | (row[k + 1] << 63),
+                                                  (below[k] << 1) | (below[k - 1] >> 63), below[k], (below[k] >> 1) | (below[k + 1] << 63));
+}
+
+// Suma a births y deaths las células que nacieron y murieron entre before y after
+LIFE_INLINE void lifeCountChanges(uint64_t before, uint64_t after, uint64_t& births, uint64_t& deaths) {
+    births += __builtin_popcountll(after & ~before);
+    deaths += __builtin_popcountll(before & ~after);
+}
+
+// Kernel escalar de respaldo: una palabra (64 células) por iteración.
+// Además de escribir la fila nueva, acumula en diff los bits que cambiaron y
+// suma en changes[0] y changes[1] los nacimientos y las muertes.
+template <int Birth = LIFE_CONWAY_BIRTH, int Survive = LIFE_CONWAY_SURVIVE>
+void lifeRowScalar(const uint64_t* above, const uint64_t* row, const uint64_t* below, uint64_t* out, uint64_t* diff, int words, uint64_t* changes) {
+    uint64_t births = 0, deaths = 0;
+    for (int k = 0; k < words; k++) {
+        out[k] = lifeRowWord<Birth, Survive>(above, row, below, k);
+        diff[k] |= out[k] ^ row[k];
+        lifeCountChanges(row[k], out[k], births, deaths);
+    }
+    changes[0] += births;
+    changes[1] += deaths;
+}
+
+#include "gameofLifeSimd.h"
 
-            int neighborX = x + i;
-            int neighborY = y + j;
+// Llena las palabras de halo de una fila según lifeBoundary
+void fillLifeRowHalo(uint64_t* row) {
+    const int lastBit = universeWidth % LIFE_WORD_BITS;
 
-            if (neighborX >= 0 && neighborX < RENDER_WIDTH && neighborY >= 0 && neighborY < RENDER_HEIGHT) {
-                if (framebuffer[neighborY * RENDER_WIDTH + neighborX].r == aliveColor.r &&
-                    framebuffer[neighborY * RENDER_WIDTH + neighborX].g == aliveColor.g &&
-                    framebuffer[neighborY * RENDER_WIDTH + neighborX].b == aliveColor.b) {
-                    aliveNeighbors++;
+    if (lifeBoundary == LIFE_BOUNDARY_WRAP) {
+        // La columna -1 es la última columna y la columna universeWidth es la primera
+        uint64_t firstCell = row[0] & 1;
+        uint64_t lastCell = (row[(universeWidth - 1) / LIFE_WORD_BITS] >> ((universeWidth - 1) % LIFE_WORD_BITS)) & 1;
+        row[-1] = lastCell << 63;
+        if (lastBit == 0) {
+            row[lifeWordsPerRow] = firstCell;
+        } else {
+            // La columna universeWidth cae en los bits de relleno de la última palabra
+            row[lifeWordsPerRow - 1] = (row[lifeWordsPerRow - 1] & lifeLastWordMask) | (firstCell << lastBit);
+            row[lifeWordsPerRow] = 0;
+        }
+    } else {
+        row[-1] = 0;
+        row[lifeWordsPerRow] = 0;
+    }
+}
+
+// Llena el halo del tablero actual según lifeBoundary
+void fillLifeHalo() {
+    for (int y = 0; y < universeHeight; y++) {
+        fillLifeRowHalo(lifeRow(lifeCells, y));
+    }
+
+    // Las filas de halo se copian completas (con sus palabras de halo) para cubrir las esquinas
+    uint64_t* top = lifeRow(lifeCells, -1) - LIFE_ROW_OFFSET;
+    uint64_t* bottom = lifeRow(lifeCells, universeHeight) - LIFE_ROW_OFFSET;
+    if (lifeBoundary == LIFE_BOUNDARY_WRAP) {
+        memcpy(top, lifeRow(lifeCells, universeHeight - 1) - LIFE_ROW_OFFSET, lifeStride * sizeof(uint64_t));
+        memcpy(bottom, lifeRow(lifeCells, 0) - LIFE_ROW_OFFSET, lifeStride * sizeof(uint64_t));
+    } else {
+        memset(top, 0, lifeStride * sizeof(uint64_t));
+        memset(bottom, 0, lifeStride * sizeof(uint64_t));
+    }
+}
+
+// Activa las teselas que cambiaron en la generación anterior y sus ocho vecinas
+// (del otro lado del borde si el universo es un toro)
+void wakeLifeTiles() {
+    bool wrap = lifeBoundary == LIFE_BOUNDARY_WRAP;
+    fill(lifeTileActive.begin(), lifeTileActive.end(), 0);
+
+    for (int ty = 0; ty < lifeTileRows; ty++) {
+        for (int tx = 0; tx < lifeTileCols; tx++) {
+            if (!lifeTileChanged[(size_t)ty * lifeTileCols + tx]) {
+                continue;
+            }
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    int ny = ty + dy;
+                    int nx = tx + dx;
+                    if (wrap) {
+                        ny = (ny + lifeTileRows) % lifeTileRows;
+                        nx = (nx + lifeTileCols) % lifeTileCols;
+                    } else if (ny < 0 || ny >= lifeTileRows || nx < 0 || nx >= lifeTileCols) {
+                        continue;
+                    }
+                    lifeTileActive[(size_t)ny * lifeTileCols + nx] = 1;
                 }
             }
         }
     }
 
-    return aliveNeighbors;
+    lifeActiveTiles = count(lifeTileActive.begin(), lifeTileActive.end(), 1);
 }
 
-void updateGameOfLife() {
-    Color newFramebuffer[FRAMEBUFFER_SIZE];
+// Tareas por hilo al repartir un ciclo dentro de un equipo ya abierto
+const int LIFE_TASKS_PER_THREAD = 4;
+
+// Hilos entre los que se reparte el trabajo: los del equipo actual si ya hay uno
+inline int lifeTeamThreads() {
+#ifdef _OPENMP
+    return omp_in_parallel() ? omp_get_num_threads() : omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+// Ejecuta body(i) para i en [0, count) repartido entre los hilos. Fuera de una
+// región paralela abre una con schedule(dynamic). Dentro de una (el equipo
+// persistente de mainParalelo4) la llama un solo hilo: las iteraciones se agrupan
+// en tareas que toman los demás hilos del equipo mientras esperan en una barrera,
+// sin abrir otro equipo, y vuelve cuando terminaron todas.
+template <typename Body>
+void lifeParallelFor(int count, const Body& body) {
+#ifdef _OPENMP
+    if (omp_in_parallel()) {
+        const int tasks = max(1, min(count, lifeTeamThreads() * LIFE_TASKS_PER_THREAD));
+        #pragma omp taskloop num_tasks(tasks)
+        for (int i = 0; i < count; i++) {
+            body(i);
+        }
+        return;
+    }
+#endif
+    #pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < count; i++) {
+        body(i);
+    }
+}
+
+// Suma a las estadísticas los nacimientos y las muertes contados por un hilo
+inline void addLifeChanges(uint64_t births, uint64_t deaths) {
+    #pragma omp atomic
+    lifeBirths += births;
+    #pragma omp atomic
+    lifeDeaths += deaths;
+}
+
+// Calcula las filas [y0, y1) en las palabras [k0, k1) y marca en "changed"
+// las teselas (una por palabra) donde alguna célula cambió
+void updateGameOfLifeSpan(int y0, int y1, int k0, int k1, uint8_t* changed) {
+    // Diferencias acumuladas por palabra; se reduce a un byte por tesela al final
+    thread_local vector<uint64_t> diff;
+    diff.assign(k1 - k0, 0);
+    uint64_t* spanDiff = diff.data();
+    uint64_t changes[2] = { 0, 0 };
+
+    for (int y = y0; y < y1; y++) {
+        uint64_t* out = lifeRow(lifeNextCells, y);
+        const uint64_t* row = lifeRow(lifeCells, y);
+
+        lifeRowKernel(lifeRow(lifeCells, y - 1) + k0, row + k0, lifeRow(lifeCells, y + 1) + k0,
+                      out + k0, spanDiff, k1 - k0, changes);
+
+        if (k1 == lifeWordsPerRow) {
+            // Los bits de relleno de la última palabra siempre quedan muertos, y
+            // lo que el kernel contó en ellos no son células
+            uint64_t padding[2] = { 0, 0 };
+            lifeCountChanges(row[k1 - 1] & ~lifeLastWordMask, out[k1 - 1] & ~lifeLastWordMask, padding[0], padding[1]);
+            changes[0] -= padding[0];
+            changes[1] -= padding[1];
+            out[k1 - 1] &= lifeLastWordMask;
+        }
+    }
+    addLifeChanges(changes[0], changes[1]);
+
+    if (k1 == lifeWordsPerRow) {
+        // En un toro la fila actual lleva la primera columna en los bits de relleno
+        spanDiff[k1 - 1 - k0] &= lifeLastWordMask;
+    }
+    for (int k = k0; k < k1; k++) {
+        changed[k] = spanDiff[k - k0] != 0;
+    }
+}
 
+#include "gameofLifeLut.h"
+#include "gameofLifeRules.h"
+
+// Función que calcula un tramo de filas y palabras (updateGameOfLifeSpan o la de tablas)
+typedef void (*LifeSpanUpdate)(int y0, int y1, int k0, int k1, uint8_t* changed);
+
+// Calcula una banda de 64 filas, agrupando las teselas activas consecutivas
+// para que el kernel recorra tramos de fila contiguos
+void updateGameOfLifeBand(int ty, LifeSpanUpdate updateSpan) {
+    const uint8_t* active = &lifeTileActive[(size_t)ty * lifeTileCols];
+    uint8_t* changed = &lifeNextTileChanged[(size_t)ty * lifeTileCols];
+    int y0 = ty * LIFE_TILE_ROWS;
+    int y1 = min(y0 + LIFE_TILE_ROWS, universeHeight);
+
+    memset(changed, 0, lifeTileCols);
+
+    int k0 = 0;
+    while (k0 < lifeTileCols) {
+        if (!active[k0]) {
+            k0++;
+            continue;
+        }
+        int k1 = k0;
+        while (k1 < lifeTileCols && active[k1]) {
+            k1++;
+        }
+        updateSpan(y0, y1, k0, k1, changed);
+        k0 = k1;
+    }
+}
+
+#include "gameofLifeScheduler.h"
+
+// Pinta en el framebuffer la región visible [x0, x1) x [y0, y1), en píxeles
+void colorizeLifeRegion(int x0, int y0, int x1, int y1) {
+    for (int y = y0; y < y1; y++) {
+        Color* pixels = &framebuffer[y * RENDER_WIDTH];
+        int cellY = lifeViewY + y;
+        if (cellY >= universeHeight) {
+            fill(pixels + x0, pixels + x1, deadColor);
+            continue;
+        }
+
+        const uint64_t* row = lifeRow(lifeCells, cellY);
+        for (int x = x0; x < x1; x++) {
+            int cellX = lifeViewX + x;
+            bool alive = cellX < universeWidth && ((row[cellX / LIFE_WORD_BITS] >> (cellX % LIFE_WORD_BITS)) & 1);
+            pixels[x] = alive ? aliveColor : deadColor;
+        }
+    }
+}
+
+// Pinta en el framebuffer toda la región visible del universo
+void colorizeGameOfLife() {
+    #pragma omp parallel for schedule(static)
     for (int y = 0; y < RENDER_HEIGHT; y++) {
-        for (int x = 0; x < RENDER_WIDTH; x++) {
-            Color currentColor = framebuffer[y * RENDER_WIDTH + x];
-            bool isAlive = (currentColor.r == aliveColor.r &&
-                            currentColor.g == aliveColor.g &&
-                            currentColor.b == aliveColor.b);
-
-            int aliveNeighbors = countAliveNeighbors(x, y);
-
-            // Aplicar las reglas del Juego de la Vida
-            if (isAlive) {
-                if (aliveNeighbors < 2 || aliveNeighbors > 3) {
-                    newFramebuffer[y * RENDER_WIDTH + x] = deadColor;
-                } else {
-                    newFramebuffer[y * RENDER_WIDTH + x] = aliveColor;
-                }
-            } else {
-                if (aliveNeighbors == 3) {
-                    newFramebuffer[y * RENDER_WIDTH + x] = aliveColor;
-                } else {
-                    newFramebuffer[y * RENDER_WIDTH + x] = deadColor;
-                }
+        colorizeLifeRegion(0, y, RENDER_WIDTH, y + 1);
+    }
+    lifeDirtyRect = { 0, 0, RENDER_WIDTH, RENDER_HEIGHT };
+}
+
+// Vuelve a pintar solo las teselas visibles que cambiaron y guarda en
+// lifeDirtyRect el rectángulo que las contiene
+void colorizeChangedTiles() {
+    int x0 = RENDER_WIDTH, y0 = RENDER_HEIGHT, x1 = 0, y1 = 0;
+
+    int firstTileY = lifeViewY / LIFE_TILE_ROWS;
+    int lastTileY = min(lifeTileRows - 1, (lifeViewY + RENDER_HEIGHT - 1) / LIFE_TILE_ROWS);
+    int firstTileX = lifeViewX / LIFE_WORD_BITS;
+    int lastTileX = min(lifeTileCols - 1, (lifeViewX + RENDER_WIDTH - 1) / LIFE_WORD_BITS);
+
+    for (int ty = firstTileY; ty <= lastTileY; ty++) {
+        for (int tx = firstTileX; tx <= lastTileX; tx++) {
+            if (!lifeTileChanged[(size_t)ty * lifeTileCols + tx]) {
+                continue;
             }
+            int tileX0 = max(0, tx * LIFE_WORD_BITS - lifeViewX);
+            int tileY0 = max(0, ty * LIFE_TILE_ROWS - lifeViewY);
+            int tileX1 = min(RENDER_WIDTH, (tx + 1) * LIFE_WORD_BITS - lifeViewX);
+            int tileY1 = min(RENDER_HEIGHT, (ty + 1) * LIFE_TILE_ROWS - lifeViewY);
+            colorizeLifeRegion(tileX0, tileY0, tileX1, tileY1);
+
+            x0 = min(x0, tileX0);
+            y0 = min(y0, tileY0);
+            x1 = max(x1, tileX1);
+            y1 = max(y1, tileY1);
         }
     }
 
-    memcpy(framebuffer, newFramebuffer, sizeof(framebuffer));
+    lifeDirtyRect = (x1 > x0) ? SDL_Rect{ x0, y0, x1 - x0, y1 - y0 } : SDL_Rect{ 0, 0, 0, 0 };
 }
 
-void initializeGameOfLife(int numGliders, int numGuns, int numSmallGliders) {
-    memset(framebuffer, 0, sizeof(framebuffer));
+// Avanza una generación con el tablero de bits
+void updateGameOfLifeGrid(LifeSpanUpdate updateSpan = updateGameOfLifeSpan) {
+    fillLifeHalo();
+    wakeLifeTiles();
 
-    vector<pair<int, int>> gliderPattern = {
-        { 1, 0 }, { 2, 1 }, { 0, 2 }, { 1, 2 }, { 2, 2 }
-    };
+    if (lifeScheduler == LIFE_SCHEDULER_STEAL) {
+        updateGameOfLifeStealing(updateSpan);
+    } else {
+        lifeParallelFor(lifeTileRows, [&](int ty) {
+            updateGameOfLifeBand(ty, updateSpan);
+        });
+    }
+
+    swap(lifeCells, lifeNextCells);
+    lifeTileChanged.swap(lifeNextTileChanged);
+    colorizeChangedTiles();
+}
+
+#include "gameofLifeTemporal.h"
+#include "gameofLifeHashLife.h"
+#include "gameofLifeStates.h"
+#include "gameofLifeSparse.h"
+#include "gameofLifeDelta.h"
+#include "gameofLifePatterns.h"
+#include "gameofLifeCycle.h"
+
+// Motores disponibles para avanzar la simulación (--engine)
+enum LifeEngine {
+    LIFE_ENGINE_BITGRID,   // Tablero de bits por teselas (lifeTemporalBlock generaciones por paso)
+    LIFE_ENGINE_LUT,       // Tablero de bits por bloques de 2x2 con la tabla de lifeTransition
+    LIFE_ENGINE_HASHLIFE,  // Quadtree con memoización (2^k generaciones por paso)
+    LIFE_ENGINE_STATES,    // Un byte por célula: reglas Generations y Larger than Life
+    LIFE_ENGINE_SPARSE,    // Lista de células vivas, con el tablero de bits cuando hay muchas
+    LIFE_ENGINE_DELTA      // Cuentas de vecinos por célula, actualizadas solo donde hubo cambios
+};
+
+LifeEngine lifeEngine = LIFE_ENGINE_BITGRID;
+
+// Lleva al tablero de bits el estado del motor activo (los motores con su propia
+// representación no lo mantienen mientras calculan). Si el tablero se escribió
+// después de que el motor lo importara, el tablero es el que está al día.
+void exportLifeEngine() {
+    if (lifeGridEdited) {
+        return;
+    }
+    if (lifeEngine == LIFE_ENGINE_HASHLIFE && hashLifeRoot != HASHLIFE_NONE) {
+        hashLifeExport();
+        colorizeGameOfLife();
+    }
+    if (lifeEngine == LIFE_ENGINE_STATES && lifeStatesLoaded) {
+        lifeStatesExport();
+        colorizeGameOfLife();
+    }
+    if (lifeEngine == LIFE_ENGINE_SPARSE && lifeSparseMode && lifeSparseLoaded) {
+        lifeSparseExport();
+        colorizeGameOfLife();
+    }
+    if (lifeEngine == LIFE_ENGINE_DELTA && lifeDeltaLoaded) {
+        lifeDeltaExport();
+        colorizeGameOfLife();
+    }
+}
+
+// Avanza lifeTemporalBlock generaciones con el tablero de bits
+void updateGameOfLifeBits() {
+    // El motor de tablas y las reglas sin kernel especializado usan la tabla de bloques
+    bool useTable = lifeEngine == LIFE_ENGINE_LUT || !lifeRowKernel;
+    if (useTable && lifeBlockTable.empty()) {
+        buildLifeBlockTable();
+    }
+
+    if (!useTable && lifeTemporalBlock > 1) {
+        updateGameOfLifeTemporal();
+        return;
+    }
+
+    for (int i = 0; i < lifeTemporalBlock; i++) {
+        updateGameOfLifeGrid(useTable ? updateGameOfLifeLutSpan : updateGameOfLifeSpan);
+    }
+}
+
+// Tablero de bits con detección de ciclos: una vez encontrado un ciclo, repite
+// las fases grabadas en lugar de calcularlas
+void updateGameOfLifeCycled() {
+    if (lifeCycleMaxPeriod == 0) {
+        updateGameOfLifeBits();
+        return;
+    }
+
+    if (lifeGridEdited || lifeTileHashes.size() != (size_t)lifeTileCols * lifeTileRows) {
+        resetLifeCycle();
+        lifeGridEdited = false;
+    }
+
+    if (lifeCycleState == LIFE_CYCLE_REPLAYING) {
+        replayLifeCycle();
+        return;
+    }
+
+    updateGameOfLifeBits();
+    recordLifeCycleStep();
+}
+
+// Motor disperso: usa la lista mientras la población sea baja y el tablero de bits
+// cuando no, revisando la densidad para cambiar de representación
+void updateGameOfLifeSparse() {
+    if (lifeSparseMode && (!lifeSparseLoaded || lifeGridEdited)) {
+        lifeSparseImport();
+    }
+    if (lifeSparseMode && !lifeSparseFits(lifeSparseCells.size(), LIFE_SPARSE_LEAVE)) {
+        lifeSparseExport();
+        lifeSparseMode = false;
+        // El tablero viene de la lista: la detección de ciclos empieza de cero
+        lifeGridEdited = true;
+    }
+
+    if (lifeSparseMode) {
+        for (int i = 0; i < lifeTemporalBlock; i++) {
+            lifeSparseStep();
+        }
+        lifeSparseColorize();
+        return;
+    }
+
+    updateGameOfLifeCycled();
+    if ((lifeGeneration / lifeTemporalBlock) % LIFE_SPARSE_CHECK_INTERVAL == 0 &&
+        lifeSparseFits(lifeGridPopulation(), LIFE_SPARSE_ENTER)) {
+        lifeSparseImport();
+        lifeSparseMode = true;
+    }
+}
+
+#include "gameofLifeProcesses.h"
+
+// Recuenta la población si el tablero de bits se escribió en bloque desde la última vez
+void syncLifePopulation() {
+    if (!lifePopulationKnown) {
+        lifePopulation = lifeGridPopulation();
+        lifePopulationKnown = true;
+    }
+}
+
+void updateGameOfLife() {
+    syncLifePopulation();
+    lifeBirths = 0;
+    lifeDeaths = 0;
+
+    if (lifeEngine == LIFE_ENGINE_HASHLIFE) {
+        lifeGeneration += hashLifeStep();
+        hashLifeColorize();
+
+        // HashLife no sigue células sueltas: solo se conoce el cambio neto
+        uint64_t population = hashLifePopulation();
+        lifeBirths = population > lifePopulation ? population - lifePopulation : 0;
+        lifeDeaths = population < lifePopulation ? lifePopulation - population : 0;
+        lifePopulation = population;
+        lifeActiveTiles = 0;
+        return;
+    }
+
+    if (lifeEngine == LIFE_ENGINE_STATES) {
+        for (int i = 0; i < lifeTemporalBlock; i++) {
+            lifeStatesStep();
+        }
+        lifeStatesColorize();
+        lifeActiveTiles = (size_t)lifeTileCols * lifeTileRows;
+    } else if (lifeEngine == LIFE_ENGINE_SPARSE) {
+        lifeActiveTiles = 0;
+        updateGameOfLifeSparse();
+    } else if (lifeEngine == LIFE_ENGINE_DELTA) {
+        updateGameOfLifeDelta();
+        lifeActiveTiles = 0;
+    } else if (lifeProcesses > 0) {
+        updateGameOfLifeProcesses();
+    } else {
+        updateGameOfLifeCycled();
+    }
+    lifePopulation += lifeBirths - lifeDeaths;
+    lifeGeneration += lifeTemporalBlock;
+}
+
+// Estadísticas de la última actualización. Nacimientos y muertes suman las
+// generaciones del paso (con bloqueo temporal o HashLife comparan solo el
+// estado inicial y el final). Las teselas activas son las que calculó el tablero
+// de bits; los motores sin teselas dan 0 y states las calcula todas.
+struct LifeStats {
+    uint64_t generation;
+    uint64_t population;
+    uint64_t births;
+    uint64_t deaths;
+    size_t activeTiles;
+};
+
+LifeStats getLifeStats() {
+    syncLifePopulation();
+    return { lifeGeneration, lifePopulation, lifeBirths, lifeDeaths, lifeActiveTiles };
+}
+
+// Resumen de las estadísticas para el título de la ventana (por omisión, las actuales)
+string formatLifeStats(const LifeStats& stats = getLifeStats()) {
+    char text[128];
+    snprintf(text, sizeof(text), "Pop: %llu (+%llu/-%llu) - Active tiles: %zu",
+             (unsigned long long)stats.population, (unsigned long long)stats.births,
+             (unsigned long long)stats.deaths, stats.activeTiles);
+    return text;
+}
+
+#include "gameofLifeFrames.h"
+
+// Generador de la sesión (splitmix64) para lo que los programas sortean mientras
+// corren, como los sprites nuevos. A diferencia del de rand(), su estado se guarda
+// en los checkpoints, así que una sesión retomada sortea lo mismo que la original.
+uint64_t lifeRandomState = 0x853C49E6748FEA9BULL;
+
+// Entero entre 0 y 2^31 - 1, como rand()
+int lifeRandom() {
+    uint64_t z = (lifeRandomState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (int)((z ^ (z >> 31)) >> 33);
+}
+
+// Semilla de la siembra de patrones (--seed). Con la misma semilla y el mismo
+// tamaño de universo el tablero inicial es el mismo, con cualquier cantidad de hilos.
+uint64_t lifeSeed = time(nullptr);
+
+// Número pseudoaleatorio que depende solo de (seed, stream, index): splitmix64
+// sobre el contador, sin estado compartido entre hilos
+inline uint64_t lifeCounterRandom(uint64_t seed, uint64_t stream, uint64_t index) {
+    uint64_t z = seed + (stream << 48) + (index + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Siembra count copias del patrón (puntos relativos a su esquina) en posiciones
+// al azar dentro del universo. La posición de la copia i sale de (lifeSeed,
+// stream, i) y las copias solo encienden células, así que pueden escribirse en
+// paralelo y en cualquier orden: las que se superponen se combinan con un OR
+// atómico por palabra y el resultado es el mismo que con un solo hilo.
+void seedLifePatterns(const vector<pair<int, int>>& points, int count, uint64_t stream) {
+    int width = 0, height = 0;
+    for (const auto& point : points) {
+        width = max(width, point.first + 1);
+        height = max(height, point.second + 1);
+    }
+    if (count <= 0 || width > universeWidth || height > universeHeight || width > LIFE_WORD_BITS) {
+        return;
+    }
+
+    // Cada fila del patrón como máscara de bits, para escribirla con una o dos palabras
+    vector<uint64_t> rows(height, 0);
+    for (const auto& point : points) {
+        rows[point.second] |= 1ULL << point.first;
+    }
+    const uint64_t rangeX = universeWidth - width + 1;
+    const uint64_t rangeY = universeHeight - height + 1;
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < count; i++) {
+        uint64_t random = lifeCounterRandom(lifeSeed, stream, i);
+        int x = ((random & 0xFFFFFFFF) * rangeX) >> 32;
+        int y = ((random >> 32) * rangeY) >> 32;
+        int k = x / LIFE_WORD_BITS;
+        int shift = x % LIFE_WORD_BITS;
+
+        for (int r = 0; r < height; r++) {
+            uint64_t* row = lifeRow(lifeCells, y + r);
+            #pragma omp atomic
+            row[k] |= rows[r] << shift;
+            if (shift && (rows[r] >> (LIFE_WORD_BITS - shift))) {
+                #pragma omp atomic
+                row[k + 1] |= rows[r] >> (LIFE_WORD_BITS - shift);
+            }
+        }
+    }
+
+    markAllLifeTilesChanged();
+}
 
-    for (int i = 0; i < numGliders; i++) {
-        int x = rand() % (RENDER_WIDTH - 5);
-        int y = rand() % (RENDER_HEIGHT - 5);
+#include "gameofLifeSoup.h"
+#include "gameofLifeCheckpoint.h"
 
-        for (const auto& point : gliderPattern) {
-            int gliderX = point.first + x;
-            int gliderY = point.second + y;
-            setPixel(gliderX, gliderY, aliveColor);
+// Siembra el universo inicial o restaura el checkpoint; false si no se pudo
+// cargar el patrón o el checkpoint pedido
+bool initializeGameOfLife(int numGliders, int numGuns, int numSmallGliders) {
+    // Los hilos se fijan antes de que toquen por primera vez el tablero
+    static bool reported = false;
+    if (!reported) {
+        applyLifeAffinity();
+    }
+    resizeGameOfLife(universeWidth, universeHeight);
+    clearLifeBuffer(lifeCells);
+    if (!reported) {
+        reportLifeMemory();
+        reported = true;
+    }
+    markAllLifeTilesChanged();
+    lifeGeneration = 0;
+    lifeStatesLoaded = false;
+    lifeSparseLoaded = false;
+    lifeSparseMode = true;
+    lifeDeltaLoaded = false;
+
+    // Un checkpoint reemplaza a los patrones sorteados
+    if (!lifeRestorePath.empty()) {
+        if (!restoreLifeCheckpoint(lifeRestorePath)) {
+            return false;
         }
+        colorizeGameOfLife();
+        return true;
+    }
+
+    // La sopa va primero: los patrones se siembran encima
+    if (lifeSoupDensity > 0) {
+        fillLifeSoup(lifeSoupDensity, lifeSoupX, lifeSoupY,
+                     lifeSoupWidth ? lifeSoupWidth : universeWidth, lifeSoupWidth ? lifeSoupHeight : universeHeight);
     }
 
+    vector<pair<int, int>> gliderPattern = {
+        { 1, 0 }, { 2, 1 }, { 0, 2 }, { 1, 2 }, { 2, 2 }
+    };
+
     vector<pair<int, int>> gunPattern = {
         { 0, 4 }, { 1, 4 }, { 0, 5 }, { 1, 5 }, { 10, 4 }, { 10, 5 }, { 10, 6 },
         { 11, 3 }, { 11, 7 }, { 12, 2 }, { 12, 8 }, { 13, 2 }, { 13, 8 }, { 14, 5 },
@@ -149,29 +943,312 @@ void initializeGameOfLife(int numGliders, int numGuns, int numSmallGliders) {
         { 35, 3 }
     };
 
-    for (int i = 0; i < numGuns; i++) {
-        int x = rand() % (RENDER_WIDTH - 35);
-        int y = rand() % (RENDER_HEIGHT - 10);
+    vector<pair<int, int>> smallGliderPattern = {
+        { 0, 0 }, { 1, 0 }, { 2, 0 }, { 0, 1 }, { 1, 2 }
+    };
+
+    // Cada tipo de patrón sortea sus posiciones con su propio flujo
+    seedLifePatterns(gliderPattern, numGliders, 0);
+    seedLifePatterns(gunPattern, numGuns, 1);
+    seedLifePatterns(smallGliderPattern, numSmallGliders, 2);
+
+    if (!lifePatternPath.empty() && !loadLifePattern(lifePatternPath, lifePatternCentered, lifePatternX, lifePatternY)) {
+        return false;
+    }
+
+    colorizeGameOfLife();
+    return true;
+}
+
+// Activa una regla dada por nombre o rulestring (la de --rule o la de un
+// checkpoint); statesRule indica si solo la puede calcular el motor states.
+// Devuelve false si el texto no es una regla válida.
+bool applyLifeRuleSpec(const string& text, bool& statesRule) {
+    int birth, survive;
+    LifeStatesRule rule;
+    vector<uint8_t> transition;
+    bool mapRule = parseLifeMapRule(text, transition);
+    if (parseLifeRule(text, birth, survive) || (mapRule && lifeTransitionMasks(transition, birth, survive))) {
+        setLifeRule(birth, survive);
+        lifeStatesRule = lifeStatesRuleFromMasks(birth, survive);
+        statesRule = false;
+    } else if (mapRule) {
+        // MAP que depende de qué vecinos están vivos, no solo de cuántos
+        setLifeTransition(transition);
+        statesRule = false;
+    } else if (parseLifeStatesRule(text, rule)) {
+        lifeStatesRule = rule;
+        statesRule = true;
+    } else {
+        return false;
+    }
+    lifeRuleSpec = text;
+    return true;
+}
+
+// Opciones de línea de comandos compartidas por todos los programas
+const char* LIFE_OPTIONS_USAGE = "[--size <width>x<height>] [--boundary dead|torus] [--engine bitgrid|lut|hashlife|states|sparse|delta] "
+                                 "[--hashlife-step <log2 generations>] [--hashlife-memory <MB>] "
+                                 "[--temporal-block <generations>] [--scheduler omp|steal] [--rule <rulestring>] [--cycle-cache <max period>] "
+                                 "[--affinity none|compact|scatter] [--huge-pages on|off] [--processes <n>] [--sim-rate <generations/s>] "
+                                 "[--pattern <file.rle|file.lif|file.cells>] [--pattern-at <x>,<y>|center] "
+                                 "[--checkpoint <file>] [--restore <file>] [--seed <n>] "
+                                 "[--soup <density>] [--soup-region <x>,<y>,<width>x<height>]";
+
+// Lee las opciones "--nombre valor" de la línea de comandos y las quita de argv,
+// para que los argumentos posicionales de cada programa no cambien
+bool parseLifeOptions(int& argc, char* argv[]) {
+    int kept = 1;
+    bool statesRule = false;
+    bool ruleGiven = false;
+    bool boundaryGiven = false;
+    LifeCheckpointHeader restoreHeader;
+    string restoreRule;
+
+    for (int i = 1; i < argc; i++) {
+        string option = argv[i];
+        if (option.rfind("--", 0) != 0) {
+            argv[kept++] = argv[i];
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            cerr << "Missing value for option " << option << endl;
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (option == "--size") {
+            int width, height;
+            if (sscanf(value, "%dx%d", &width, &height) != 2 ||
+                width < LIFE_MIN_DIMENSION || width > LIFE_MAX_DIMENSION ||
+                height < LIFE_MIN_DIMENSION || height > LIFE_MAX_DIMENSION) {
+                cerr << "Invalid universe size '" << value << "' (expected WxH between "
+                     << LIFE_MIN_DIMENSION << " and " << LIFE_MAX_DIMENSION << ")" << endl;
+                return false;
+            }
+            universeWidth = width;
+            universeHeight = height;
+        } else if (option == "--boundary") {
+            string boundary = value;
+            if (boundary == "dead") {
+                lifeBoundary = LIFE_BOUNDARY_DEAD;
+            } else if (boundary == "torus") {
+                lifeBoundary = LIFE_BOUNDARY_WRAP;
+            } else {
+                cerr << "Unknown boundary '" << boundary << "' (expected dead or torus)" << endl;
+                return false;
+            }
+            boundaryGiven = true;
+        } else if (option == "--engine") {
+            string engine = value;
+            if (engine == "bitgrid") {
+                lifeEngine = LIFE_ENGINE_BITGRID;
+            } else if (engine == "lut") {
+                lifeEngine = LIFE_ENGINE_LUT;
+            } else if (engine == "hashlife") {
+                lifeEngine = LIFE_ENGINE_HASHLIFE;
+            } else if (engine == "states") {
+                lifeEngine = LIFE_ENGINE_STATES;
+            } else if (engine == "sparse") {
+                lifeEngine = LIFE_ENGINE_SPARSE;
+            } else if (engine == "delta") {
+                lifeEngine = LIFE_ENGINE_DELTA;
+            } else {
+                cerr << "Unknown engine '" << engine << "' (expected bitgrid, lut, hashlife, states, sparse or delta)" << endl;
+                return false;
+            }
+        } else if (option == "--hashlife-step") {
+            int stepLog = atoi(value);
+            if (stepLog < 0 || stepLog > 60) {
+                cerr << "Invalid HashLife step '" << value << "' (expected 0 to 60)" << endl;
+                return false;
+            }
+            hashLifeStepLog = stepLog;
+        } else if (option == "--hashlife-memory") {
+            // Solo dígitos: con signo strtoull da la vuelta, y si no cabe satura sobre el máximo
+            char* end;
+            unsigned long long megabytes = strtoull(value, &end, 10);
+            if (!isdigit((unsigned char)*value) || *end || megabytes < 16 || megabytes > HASHLIFE_MAX_MEMORY_MB) {
+                cerr << "Invalid HashLife memory cap '" << value << "' (expected 16 to " << HASHLIFE_MAX_MEMORY_MB << " MB)" << endl;
+                return false;
+            }
+            hashLifeMemoryMB = megabytes;
+        } else if (option == "--temporal-block") {
+            int generations = atoi(value);
+            if (generations < 1 || generations > LIFE_TILE_ROWS) {
+                cerr << "Invalid temporal block '" << value << "' (expected 1 to " << LIFE_TILE_ROWS << ")" << endl;
+                return false;
+            }
+            lifeTemporalBlock = generations;
+        } else if (option == "--scheduler") {
+            string scheduler = value;
+            if (scheduler == "omp") {
+                lifeScheduler = LIFE_SCHEDULER_OMP;
+            } else if (scheduler == "steal") {
+                lifeScheduler = LIFE_SCHEDULER_STEAL;
+            } else {
+                cerr << "Unknown scheduler '" << scheduler << "' (expected omp or steal)" << endl;
+                return false;
+            }
+        } else if (option == "--affinity") {
+            string affinity = value;
+            if (affinity == "none") {
+                lifeAffinity = LIFE_AFFINITY_NONE;
+            } else if (affinity == "compact") {
+                lifeAffinity = LIFE_AFFINITY_COMPACT;
+            } else if (affinity == "scatter") {
+                lifeAffinity = LIFE_AFFINITY_SCATTER;
+            } else {
+                cerr << "Unknown affinity '" << affinity << "' (expected none, compact or scatter)" << endl;
+                return false;
+            }
+        } else if (option == "--huge-pages") {
+            string hugePages = value;
+            if (hugePages == "on" || hugePages == "off") {
+                lifeHugePages = hugePages == "on";
+            } else {
+                cerr << "Invalid huge pages setting '" << hugePages << "' (expected on or off)" << endl;
+                return false;
+            }
+        } else if (option == "--processes") {
+            int processes = atoi(value);
+            if (processes < 0 || processes > 1024) {
+                cerr << "Invalid process count '" << value << "' (expected 0 to 1024)" << endl;
+                return false;
+            }
+            lifeProcesses = processes;
+            lifeSharedBuffers = processes > 0;
+        } else if (option == "--sim-rate") {
+            char* end;
+            double rate = strtod(value, &end);
+            if (end == value || *end || !(rate >= 0 && rate <= 1e6)) {
+                cerr << "Invalid simulation rate '" << value << "' (expected 0 to 1000000 generations per second)" << endl;
+                return false;
+            }
+            lifeSimulationRate = rate;
+        } else if (option == "--cycle-cache") {
+            int period = atoi(value);
+            if (period < 0 || period > 4096) {
+                cerr << "Invalid cycle cache period '" << value << "' (expected 0 to 4096)" << endl;
+                return false;
+            }
+            lifeCycleMaxPeriod = period;
+        } else if (option == "--pattern") {
+            if (access(value, R_OK) != 0) {
+                cerr << "Cannot read pattern file '" << value << "'" << endl;
+                return false;
+            }
+            lifePatternPath = value;
+        } else if (option == "--pattern-at") {
+            long long x, y;
+            if (string(value) == "center") {
+                lifePatternCentered = true;
+            } else if (sscanf(value, "%lld,%lld", &x, &y) == 2) {
+                lifePatternCentered = false;
+                lifePatternX = x;
+                lifePatternY = y;
+            } else {
+                cerr << "Invalid pattern position '" << value << "' (expected <x>,<y> or center)" << endl;
+                return false;
+            }
+        } else if (option == "--checkpoint") {
+            lifeCheckpointPath = value;
+        } else if (option == "--restore") {
+            // El tamaño del universo sale del checkpoint; la regla y el borde, al final
+            if (!readLifeCheckpointHeader(value, restoreHeader, restoreRule)) {
+                cerr << "Cannot read checkpoint '" << value << "'" << endl;
+                return false;
+            }
+            lifeRestorePath = value;
+            universeWidth = restoreHeader.width;
+            universeHeight = restoreHeader.height;
+        } else if (option == "--seed") {
+            char* end;
+            unsigned long long seed = strtoull(value, &end, 10);
+            if (!isdigit((unsigned char)value[0]) || *end) {
+                cerr << "Invalid seed '" << value << "' (expected a non-negative integer)" << endl;
+                return false;
+            }
+            lifeSeed = seed;
+        } else if (option == "--soup") {
+            char* end;
+            double density = strtod(value, &end);
+            if (end == value || *end || !(density >= 0 && density <= 1)) {
+                cerr << "Invalid soup density '" << value << "' (expected 0 to 1)" << endl;
+                return false;
+            }
+            lifeSoupDensity = density;
+        } else if (option == "--soup-region") {
+            int x, y, width, height;
+            if (sscanf(value, "%d,%d,%dx%d", &x, &y, &width, &height) != 4 || width <= 0 || height <= 0) {
+                cerr << "Invalid soup region '" << value << "' (expected <x>,<y>,<width>x<height>)" << endl;
+                return false;
+            }
+            lifeSoupX = x;
+            lifeSoupY = y;
+            lifeSoupWidth = width;
+            lifeSoupHeight = height;
+        } else if (option == "--rule") {
+            if (!applyLifeRuleSpec(value, statesRule)) {
+                cerr << "Invalid rule '" << value << "' (expected a name, B<digits>/S<digits>, "
+                     << "B<digits>/S<digits>/C<states>, R<radius>,C<states>,M<0|1>,S<min>..<max>,B<min>..<max>,NM or MAP<base64>)" << endl;
+                return false;
+            }
+            if (statesRule ? lifeStatesRule.birth[0] : lifeTransition[0]) {
+                // Con B0 el fondo vacío se enciende y ninguna tesela quieta se podría saltar
+                cerr << "Rules with B0 are not supported" << endl;
+                return false;
+            }
+            ruleGiven = true;
+        } else {
+            cerr << "Unknown option " << option << endl;
+            return false;
+        }
+    }
 
-        for (const auto& point : gunPattern) {
-            int gunX = point.first + x;
-            int gunY = point.second + y;
-            setPixel(gunX, gunY, aliveColor);
+    // Un checkpoint se retoma con su regla y su borde, o no sería la misma sesión
+    if (!lifeRestorePath.empty()) {
+        bool ruleDiffers = ruleGiven && lifeRuleSpec != restoreRule;
+        if (!applyLifeRuleSpec(restoreRule, statesRule)) {
+            cerr << "Checkpoint '" << lifeRestorePath << "' has an unknown rule '" << restoreRule << "'" << endl;
+            return false;
+        }
+        if (ruleDiffers) {
+            cerr << "Warning: resuming with the checkpoint rule " << restoreRule << "; --rule is ignored" << endl;
+        }
+        if (boundaryGiven && lifeBoundary != (LifeBoundary)restoreHeader.boundary) {
+            cerr << "Warning: resuming with the checkpoint boundary; --boundary is ignored" << endl;
         }
+        lifeBoundary = (LifeBoundary)restoreHeader.boundary;
     }
 
-    vector<pair<int, int>> smallGliderPattern = {
-        { 0, 0 }, { 1, 0 }, { 2, 0 }, { 0, 1 }, { 1, 2 }
-    };
+    // HashLife calcula sobre un plano infinito: no tiene bordes que unir
+    if (lifeEngine == LIFE_ENGINE_HASHLIFE && lifeBoundary == LIFE_BOUNDARY_WRAP) {
+        cerr << "Warning: HashLife simulates an unbounded plane; --boundary torus is ignored" << endl;
+    }
 
-    for (int i = 0; i < numSmallGliders; i++) {
-        int x = rand() % (RENDER_WIDTH - 2);
-        int y = rand() % (RENDER_HEIGHT - 2);
+    // Los procesos trabajadores solo calculan el tablero de bits
+    if (lifeProcesses > 0 && lifeEngine != LIFE_ENGINE_BITGRID && lifeEngine != LIFE_ENGINE_LUT) {
+        cerr << "Warning: --processes only applies to the bitgrid and lut engines; it is ignored" << endl;
+    }
 
-        for (const auto& point : smallGliderPattern) {
-            int gliderX = point.first + x;
-            int gliderY = point.second + y;
-            setPixel(gliderX, gliderY, aliveColor);
+    // Las reglas de varios estados o de radio grande solo las calcula el motor states
+    if (statesRule) {
+        if (lifeEngine != LIFE_ENGINE_BITGRID && lifeEngine != LIFE_ENGINE_STATES) {
+            cerr << "Generations and Larger than Life rules need --engine states" << endl;
+            return false;
         }
+        lifeEngine = LIFE_ENGINE_STATES;
+    }
+
+    // Los motores que cuentan vecinos no pueden calcular una regla no totalística
+    if (!lifeRuleTotalistic && (lifeEngine == LIFE_ENGINE_STATES || lifeEngine == LIFE_ENGINE_SPARSE || lifeEngine == LIFE_ENGINE_DELTA)) {
+        cerr << "Non-totalistic MAP rules need --engine bitgrid, lut or hashlife" << endl;
+        return false;
     }
+
+    argc = kept;
+    argv[argc] = nullptr;
+    return true;
 }
@@ -0,0 +1,446 @@
+// Checkpoints: guardan el estado completo de la simulación (tablero, generación,
+// borde, regla, estado de lifeRandom() y los sprites del programa) en un archivo
+// binario compacto, para retomar una sesión sin volver a sembrar ni calcular las
+// generaciones ya hechas. Cada tesela de 64x64 se guarda vacía, como tiradas o
+// como mapa de bits, lo que ocupe menos, y un índice dice dónde está cada una.
+// Con las reglas de varios estados del motor states, un segundo índice guarda
+// los bytes de las teselas que tienen células muriendo. Al restaurar, el archivo
+// se mapea en memoria y se decodifican en paralelo por bandas solo las teselas
+// que no están vacías; las páginas de las demás ni se tocan. La regla y el borde
+// del checkpoint reemplazan a los de la línea de comandos (ver parseLifeOptions).
+// Los enteros quedan en el orden de bytes de la máquina que guardó.
+// Se incluye desde gameofLife.h.
+
+const char LIFE_CHECKPOINT_MAGIC[8] = { 'G', 'O', 'L', 'C', 'K', 'P', 'T', '1' };
+const uint32_t LIFE_CHECKPOINT_VERSION = 2;
+// Largo máximo del texto de la regla
+const uint64_t LIFE_CHECKPOINT_MAX_RULE = 256;
+
+// Archivo que se escribe al salir (--checkpoint) y el que se restaura al inicializar (--restore)
+string lifeCheckpointPath;
+string lifeRestorePath;
+
+// Cabecera al principio del archivo; los offsets son desde el comienzo del archivo
+struct LifeCheckpointHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t boundary;
+    uint32_t ruleBytes;          // Texto de lifeRuleSpec, sin terminador
+    uint64_t ruleOffset;
+    uint64_t generation;
+    uint64_t randomState;
+    uint64_t indexOffset;        // lifeTileCols * lifeTileRows entradas LifeCheckpointTile, por bandas
+    uint64_t statesIndexOffset;  // Otras tantas con los estados del motor states, o 0 si no hay
+    uint64_t spriteOffset;
+    uint64_t spriteSize;    // Bytes de cada sprite
+    uint64_t spriteCount;
+    uint64_t fileSize;
+};
+
+enum LifeCheckpointEncoding : uint32_t {
+    LIFE_CHECKPOINT_EMPTY,   // Sin células vivas, no ocupa nada
+    LIFE_CHECKPOINT_RUNS,    // Tiradas de uint16_t (ver encodeLifeTileRuns)
+    LIFE_CHECKPOINT_BITMAP,  // Una palabra por fila
+    LIFE_CHECKPOINT_STATES   // Un byte por célula con su estado (solo las que mueren, las demás en 0)
+};
+
+struct LifeCheckpointTile {
+    uint64_t offset;
+    uint32_t bytes;
+    uint32_t encoding;
+};
+
+// Sprites del último checkpoint restaurado, hasta que el programa los toma
+vector<uint8_t> lifeCheckpointSprites;
+size_t lifeCheckpointSpriteSize = 0;
+
+// Tiradas alternadas de muertas y vivas (empezando por muertas) sobre los bits de
+// la tesela, fila por fila; la última tirada de muertas no se guarda. Una tirada
+// mide a lo sumo 64 * 64 bits, así que alcanza con 16 bits. Deja de contar y
+// devuelve false al pasar de maxRuns tiradas (el mapa de bits ocupa menos).
+bool encodeLifeTileRuns(const uint64_t* words, int rows, size_t maxRuns, vector<uint16_t>& runs) {
+    runs.clear();
+    const int total = rows * LIFE_WORD_BITS;
+    int pos = 0;
+    bool alive = false;
+    while (pos < total) {
+        // Siguiente bit distinto del estado de la tirada actual
+        int next = total;
+        for (int i = pos / LIFE_WORD_BITS; i < rows; i++) {
+            uint64_t different = alive ? ~words[i] : words[i];
+            if (i == pos / LIFE_WORD_BITS) {
+                different &= ~0ULL << (pos % LIFE_WORD_BITS);
+            }
+            if (different) {
+                next = i * LIFE_WORD_BITS + __builtin_ctzll(different);
+                break;
+            }
+        }
+        if (next == total && !alive) {
+            break;
+        }
+        if (runs.size() == maxRuns) {
+            return false;
+        }
+        runs.push_back(next - pos);
+        pos = next;
+        alive = !alive;
+    }
+    return true;
+}
+
+// Escribe las tiradas en las palabras de la tesela; devuelve false si se salen de ella
+bool decodeLifeTileRuns(const uint16_t* runs, size_t count, uint64_t* const* words, int rows) {
+    const int total = rows * LIFE_WORD_BITS;
+    int pos = 0;
+    for (size_t i = 0; i < count; i++) {
+        int length = runs[i];
+        if (length > total - pos) {
+            return false;
+        }
+        if (i & 1) {
+            for (int end = pos + length; pos < end;) {
+                int bit = pos % LIFE_WORD_BITS;
+                int take = min(end - pos, LIFE_WORD_BITS - bit);
+                uint64_t mask = take == LIFE_WORD_BITS ? ~0ULL : ((1ULL << take) - 1) << bit;
+                *words[pos / LIFE_WORD_BITS] |= mask;
+                pos += take;
+            }
+        } else {
+            pos += length;
+        }
+    }
+    return true;
+}
+
+// Revisa que la cabecera sea de un checkpoint que esta versión puede leer
+bool validLifeCheckpointHeader(const LifeCheckpointHeader& header) {
+    return memcmp(header.magic, LIFE_CHECKPOINT_MAGIC, sizeof(header.magic)) == 0 &&
+           header.version == LIFE_CHECKPOINT_VERSION &&
+           header.width >= (uint32_t)LIFE_MIN_DIMENSION && header.width <= (uint32_t)LIFE_MAX_DIMENSION &&
+           header.height >= (uint32_t)LIFE_MIN_DIMENSION && header.height <= (uint32_t)LIFE_MAX_DIMENSION &&
+           header.boundary <= LIFE_BOUNDARY_WRAP &&
+           header.ruleBytes > 0 && header.ruleBytes <= LIFE_CHECKPOINT_MAX_RULE;
+}
+
+// Lee solo la cabecera y la regla (para conocer el tamaño del universo y la
+// regla antes de reservarlo y de elegir el motor)
+bool readLifeCheckpointHeader(const string& path, LifeCheckpointHeader& header, string& rule) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool valid = read(fd, &header, sizeof(header)) == (ssize_t)sizeof(header) && validLifeCheckpointHeader(header);
+    if (valid) {
+        rule.resize(header.ruleBytes);
+        valid = pread(fd, &rule[0], rule.size(), header.ruleOffset) == (ssize_t)rule.size();
+    }
+    close(fd);
+    return valid;
+}
+
+// Las reglas de varios estados guardan también los estados de las células que mueren
+inline bool lifeCheckpointHasStates() {
+    return lifeEngine == LIFE_ENGINE_STATES && lifeStatesLoaded && lifeStatesRule.states > 2;
+}
+
+// Guarda el estado actual. Los sprites se copian tal cual (spriteCount registros
+// de spriteSize bytes), así que deben ser tipos sin punteros. Se escribe en un
+// archivo temporal que después reemplaza al destino, para no dejar a medias un
+// checkpoint anterior.
+bool saveLifeCheckpoint(const string& path, const void* sprites = nullptr, size_t spriteSize = 0, size_t spriteCount = 0) {
+    if (lifeRuleSpec.empty() || lifeRuleSpec.size() > LIFE_CHECKPOINT_MAX_RULE) {
+        cerr << "Cannot save rule '" << lifeRuleSpec << "' in a checkpoint" << endl;
+        return false;
+    }
+
+    // Los motores con su propia representación no mantienen el tablero de bits
+    exportLifeEngine();
+
+    const size_t tiles = (size_t)lifeTileCols * lifeTileRows;
+    const bool hasStates = lifeCheckpointHasStates();
+    vector<LifeCheckpointTile> index(tiles);
+    vector<LifeCheckpointTile> statesIndex(hasStates ? tiles : 0);
+    vector<vector<uint8_t>> bands(lifeTileRows);
+
+    // Cada banda se codifica en su propio búfer, con offsets relativos a él
+    #pragma omp parallel for schedule(dynamic)
+    for (int ty = 0; ty < lifeTileRows; ty++) {
+        int y0 = ty * LIFE_TILE_ROWS;
+        int rows = min(LIFE_TILE_ROWS, universeHeight - y0);
+        vector<uint8_t>& data = bands[ty];
+        vector<uint16_t> runs;
+        uint64_t words[LIFE_TILE_ROWS];
+
+        for (int tx = 0; tx < lifeTileCols; tx++) {
+            uint64_t mask = tx == lifeTileCols - 1 ? lifeLastWordMask : ~0ULL;
+            uint64_t any = 0;
+            for (int r = 0; r < rows; r++) {
+                words[r] = lifeRow(lifeCells, y0 + r)[tx] & mask;
+                any |= words[r];
+            }
+
+            LifeCheckpointTile& tile = index[(size_t)ty * lifeTileCols + tx];
+            tile = { data.size(), 0, LIFE_CHECKPOINT_EMPTY };
+            if (!any) {
+                continue;
+            }
+
+            const void* source = words;
+            tile.encoding = LIFE_CHECKPOINT_BITMAP;
+            tile.bytes = rows * sizeof(uint64_t);
+            if (encodeLifeTileRuns(words, rows, tile.bytes / sizeof(uint16_t) - 1, runs)) {
+                source = runs.data();
+                tile.encoding = LIFE_CHECKPOINT_RUNS;
+                tile.bytes = runs.size() * sizeof(uint16_t);
+            }
+            // Cada tesela empieza alineada a 8 bytes para leer el mapa de bits sin copiarlo
+            data.insert(data.end(), (const uint8_t*)source, (const uint8_t*)source + tile.bytes);
+            data.resize((data.size() + 7) / 8 * 8, 0);
+        }
+
+        // Estados de las teselas con células muriendo, a continuación en la misma banda
+        for (int tx = 0; hasStates && tx < lifeTileCols; tx++) {
+            int x0 = tx * LIFE_WORD_BITS;
+            int cols = min(LIFE_WORD_BITS, universeWidth - x0);
+            LifeCheckpointTile& tile = statesIndex[(size_t)ty * lifeTileCols + tx];
+            tile = { data.size(), 0, LIFE_CHECKPOINT_EMPTY };
+            size_t start = data.size();
+            bool dying = false;
+            for (int r = 0; r < rows; r++) {
+                const uint8_t* states = &lifeStates[(size_t)(y0 + r) * universeWidth + x0];
+                for (int x = 0; x < cols; x++) {
+                    data.push_back(states[x] >= 2 ? states[x] : 0);
+                    dying |= states[x] >= 2;
+                }
+            }
+            if (!dying) {
+                data.resize(start);
+                continue;
+            }
+            tile.encoding = LIFE_CHECKPOINT_STATES;
+            tile.bytes = data.size() - start;
+            data.resize((data.size() + 7) / 8 * 8, 0);
+        }
+    }
+
+    LifeCheckpointHeader header = {};
+    memcpy(header.magic, LIFE_CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = LIFE_CHECKPOINT_VERSION;
+    header.width = universeWidth;
+    header.height = universeHeight;
+    header.boundary = lifeBoundary;
+    header.generation = lifeGeneration;
+    header.randomState = lifeRandomState;
+    header.indexOffset = sizeof(header);
+    header.statesIndexOffset = hasStates ? header.indexOffset + tiles * sizeof(LifeCheckpointTile) : 0;
+    header.ruleOffset = header.indexOffset + (hasStates ? 2 : 1) * tiles * sizeof(LifeCheckpointTile);
+    header.ruleBytes = lifeRuleSpec.size();
+    header.spriteOffset = header.ruleOffset + header.ruleBytes;
+    header.spriteSize = sprites ? spriteSize : 0;
+    header.spriteCount = sprites ? spriteCount : 0;
+
+    const uint64_t spriteBytes = header.spriteSize * header.spriteCount;
+    const uint64_t dataOffset = (header.spriteOffset + spriteBytes + 7) / 8 * 8;
+    uint64_t offset = dataOffset;
+    for (int ty = 0; ty < lifeTileRows; ty++) {
+        for (int tx = 0; tx < lifeTileCols; tx++) {
+            index[(size_t)ty * lifeTileCols + tx].offset += offset;
+            if (hasStates) {
+                statesIndex[(size_t)ty * lifeTileCols + tx].offset += offset;
+            }
+        }
+        offset += bands[ty].size();
+    }
+    header.fileSize = offset;
+
+    string temporary = path + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (!file) {
+        cerr << "Cannot write checkpoint '" << path << "'" << endl;
+        return false;
+    }
+    const uint8_t padding[8] = {};
+    const size_t paddingBytes = dataOffset - header.spriteOffset - spriteBytes;
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(index.data(), sizeof(LifeCheckpointTile), tiles, file) == tiles &&
+                   fwrite(statesIndex.data(), sizeof(LifeCheckpointTile), statesIndex.size(), file) == statesIndex.size() &&
+                   fwrite(lifeRuleSpec.data(), 1, lifeRuleSpec.size(), file) == lifeRuleSpec.size() &&
+                   (spriteBytes == 0 || fwrite(sprites, 1, spriteBytes, file) == spriteBytes) &&
+                   fwrite(padding, 1, paddingBytes, file) == paddingBytes;
+    for (int ty = 0; written && ty < lifeTileRows; ty++) {
+        written = fwrite(bands[ty].data(), 1, bands[ty].size(), file) == bands[ty].size();
+    }
+    written = fclose(file) == 0 && written;
+
+    if (!written || rename(temporary.c_str(), path.c_str()) != 0) {
+        remove(temporary.c_str());
+        cerr << "Cannot write checkpoint '" << path << "'" << endl;
+        return false;
+    }
+    return true;
+}
+
+// Restaura el estado guardado: cambia el tamaño del universo, escribe el tablero
+// (y los estados del motor states) y recupera generación, borde y generador. La
+// regla ya la aplicó parseLifeOptions; si la activa no es la guardada, el
+// checkpoint se rechaza. Los sprites quedan en lifeCheckpointSprites hasta que
+// el programa los tome (takeLifeCheckpointSprites).
+bool restoreLifeCheckpoint(const string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        cerr << "Cannot open checkpoint '" << path << "'" << endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(LifeCheckpointHeader)) {
+        close(fd);
+        cerr << "Invalid checkpoint '" << path << "'" << endl;
+        return false;
+    }
+
+    size_t size = info.st_size;
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        cerr << "Cannot map checkpoint '" << path << "'" << endl;
+        return false;
+    }
+    const uint8_t* begin = static_cast<const uint8_t*>(mapped);
+
+    LifeCheckpointHeader header;
+    memcpy(&header, begin, sizeof(header));
+    int tileCols = (header.width + LIFE_WORD_BITS - 1) / LIFE_WORD_BITS;
+    int tileRows = (header.height + LIFE_TILE_ROWS - 1) / LIFE_TILE_ROWS;
+    size_t tiles = (size_t)tileCols * tileRows;
+    bool valid = validLifeCheckpointHeader(header) && header.fileSize == size &&
+                 header.indexOffset % 8 == 0 && header.indexOffset <= size &&
+                 tiles <= (size - header.indexOffset) / sizeof(LifeCheckpointTile) &&
+                 header.statesIndexOffset % 8 == 0 && header.statesIndexOffset <= size &&
+                 tiles <= (size - header.statesIndexOffset) / sizeof(LifeCheckpointTile) &&
+                 header.ruleOffset <= size && header.ruleBytes <= size - header.ruleOffset &&
+                 header.spriteOffset <= size &&
+                 (header.spriteSize == 0 || header.spriteCount <= (size - header.spriteOffset) / header.spriteSize);
+
+    // Seguir con otra regla no retomaría la sesión, sino otra distinta
+    if (valid && string((const char*)begin + header.ruleOffset, header.ruleBytes) != lifeRuleSpec) {
+        munmap(mapped, size);
+        cerr << "Checkpoint '" << path << "' was saved with rule '"
+             << string((const char*)begin + header.ruleOffset, header.ruleBytes)
+             << "', not the active rule '" << lifeRuleSpec << "'" << endl;
+        return false;
+    }
+    const bool hasStates = valid && header.statesIndexOffset != 0;
+    if (hasStates && lifeEngine != LIFE_ENGINE_STATES) {
+        munmap(mapped, size);
+        cerr << "Checkpoint '" << path << "' holds cell states that only the states engine can resume" << endl;
+        return false;
+    }
+
+    if (valid) {
+        resizeGameOfLife(header.width, header.height);
+        memset(lifeCells, 0, lifeWords * sizeof(uint64_t));
+        if (hasStates) {
+            lifeStates.assign((size_t)universeWidth * universeHeight, 0);
+            lifeNextStates.assign(lifeStates.size(), 0);
+        }
+
+        const LifeCheckpointTile* index = reinterpret_cast<const LifeCheckpointTile*>(begin + header.indexOffset);
+        const LifeCheckpointTile* statesIndex = reinterpret_cast<const LifeCheckpointTile*>(begin + header.statesIndexOffset);
+        #pragma omp parallel for schedule(dynamic) reduction(&&:valid)
+        for (int ty = 0; ty < lifeTileRows; ty++) {
+            int y0 = ty * LIFE_TILE_ROWS;
+            int rows = min(LIFE_TILE_ROWS, universeHeight - y0);
+            uint64_t* words[LIFE_TILE_ROWS];
+
+            for (int tx = 0; tx < lifeTileCols; tx++) {
+                const LifeCheckpointTile& tile = index[(size_t)ty * lifeTileCols + tx];
+                if (tile.encoding == LIFE_CHECKPOINT_EMPTY) {
+                    continue;
+                }
+                if (tile.offset % 8 != 0 || tile.offset > size || tile.bytes > size - tile.offset) {
+                    valid = false;
+                    continue;
+                }
+                for (int r = 0; r < rows; r++) {
+                    words[r] = &lifeRow(lifeCells, y0 + r)[tx];
+                }
+
+                uint64_t mask = tx == lifeTileCols - 1 ? lifeLastWordMask : ~0ULL;
+                if (tile.encoding == LIFE_CHECKPOINT_BITMAP && tile.bytes == rows * sizeof(uint64_t)) {
+                    const uint64_t* bitmap = reinterpret_cast<const uint64_t*>(begin + tile.offset);
+                    for (int r = 0; r < rows; r++) {
+                        *words[r] = bitmap[r] & mask;
+                    }
+                } else if (tile.encoding == LIFE_CHECKPOINT_RUNS && tile.bytes % sizeof(uint16_t) == 0) {
+                    const uint16_t* runs = reinterpret_cast<const uint16_t*>(begin + tile.offset);
+                    valid = decodeLifeTileRuns(runs, tile.bytes / sizeof(uint16_t), words, rows) && valid;
+                    for (int r = 0; r < rows; r++) {
+                        *words[r] &= mask;
+                    }
+                } else {
+                    valid = false;
+                }
+            }
+
+            // Las células vivas ya están en el tablero; aquí solo vuelven las que mueren
+            for (int tx = 0; hasStates && tx < lifeTileCols; tx++) {
+                const LifeCheckpointTile& tile = statesIndex[(size_t)ty * lifeTileCols + tx];
+                if (tile.encoding == LIFE_CHECKPOINT_EMPTY) {
+                    continue;
+                }
+                int x0 = tx * LIFE_WORD_BITS;
+                int cols = min(LIFE_WORD_BITS, universeWidth - x0);
+                if (tile.encoding != LIFE_CHECKPOINT_STATES || tile.bytes != (uint32_t)(rows * cols) ||
+                    tile.offset > size || tile.bytes > size - tile.offset) {
+                    valid = false;
+                    continue;
+                }
+                const uint8_t* saved = begin + tile.offset;
+                for (int r = 0; r < rows; r++) {
+                    uint8_t* states = &lifeStates[(size_t)(y0 + r) * universeWidth + x0];
+                    for (int x = 0; x < cols; x++) {
+                        uint8_t state = saved[r * cols + x];
+                        states[x] = (state >= 2 && state < lifeStatesRule.states) ? state : 0;
+                    }
+                }
+            }
+        }
+    }
+
+    if (valid) {
+        lifeGeneration = header.generation;
+        lifeBoundary = (LifeBoundary)header.boundary;
+        lifeRandomState = header.randomState;
+        lifeCheckpointSpriteSize = header.spriteSize;
+        const uint8_t* sprites = begin + header.spriteOffset;
+        lifeCheckpointSprites.assign(sprites, sprites + header.spriteSize * header.spriteCount);
+        // El motor states toma el tablero conservando los estados restaurados
+        lifeStatesLoaded = hasStates;
+    } else {
+        if (lifeCells) {
+            memset(lifeCells, 0, lifeWords * sizeof(uint64_t));
+        }
+        cerr << "Invalid checkpoint '" << path << "'" << endl;
+    }
+
+    munmap(mapped, size);
+    markAllLifeTilesChanged();
+    return valid;
+}
+
+// Reemplaza sprites por los del último checkpoint restaurado (hasta maxCount) si
+// se guardaron con el mismo tipo; devuelve false si no había sprites que tomar
+template <typename Sprite>
+bool takeLifeCheckpointSprites(vector<Sprite>& sprites, size_t maxCount) {
+    if (lifeCheckpointSprites.empty() || lifeCheckpointSpriteSize != sizeof(Sprite)) {
+        return false;
+    }
+    size_t count = min(lifeCheckpointSprites.size() / sizeof(Sprite), maxCount);
+    sprites.resize(count);
+    memcpy(sprites.data(), lifeCheckpointSprites.data(), count * sizeof(Sprite));
+    lifeCheckpointSprites.clear();
+    return true;
+}
@@ -0,0 +1,231 @@
+// Detección de ciclos para el tablero de bits. Cada tesela tiene un hash de 64 bits
+// y el hash del tablero es el XOR de todos, así que solo se recalculan las bandas
+// con teselas que cambiaron. El hash se toma cada LIFE_CYCLE_SAMPLE generaciones:
+// como la evolución es determinista, si el tablero repite un estado de hace P
+// generaciones repetirá las siguientes P para siempre. P es un múltiplo del
+// período real, así que mientras se graban las teselas que cambian en cada
+// generación se toma el hash en todas: la primera que vuelve al de partida (y
+// divide a P) da el período exacto, y sirve también de confirmación por si hubo
+// una colisión. Desde ahí cada generación solo copia las teselas grabadas de
+// su fase, sin calcular nada.
+// Editar el tablero, cambiar de motor o de tamaño corta la repetición.
+// Se incluye desde gameofLife.h.
+
+// Período máximo que se busca, en generaciones (--cycle-cache); 0 desactiva la
+// detección. Se guardan tantas muestras como este valor, así que además de
+// cualquier período hasta él se encuentran los múltiplos de LIFE_CYCLE_SAMPLE
+// hasta LIFE_CYCLE_SAMPLE veces más largos.
+int lifeCycleMaxPeriod = 64;
+// Cada cuántas generaciones se toma el hash del tablero
+const int LIFE_CYCLE_SAMPLE = 8;
+// Límite de teselas grabadas por ciclo (64 palabras cada una)
+const size_t LIFE_CYCLE_MAX_RECORDED_TILES = 1 << 16;
+
+enum LifeCycleState {
+    LIFE_CYCLE_SEARCHING,  // Guardando hashes y buscando una repetición
+    LIFE_CYCLE_RECORDING,  // Grabando un período
+    LIFE_CYCLE_REPLAYING   // Repitiendo las fases grabadas
+};
+
+// Teselas que cambian en una fase del ciclo: su índice y sus palabras nuevas,
+// más los nacimientos y muertes de esa generación para las estadísticas
+struct LifeCycleFrame {
+    vector<uint32_t> tiles;
+    vector<uint64_t> words;
+    uint64_t births;
+    uint64_t deaths;
+};
+
+LifeCycleState lifeCycleState = LIFE_CYCLE_SEARCHING;
+vector<uint64_t> lifeTileHashes;
+vector<uint8_t> lifeTileDirty;         // Teselas cambiadas desde el último hash
+uint64_t lifeGridHash = 0;
+vector<uint64_t> lifeCycleHistory;     // Hashes de las últimas muestras, en un anillo
+uint64_t lifeCycleSteps = 0;           // Generaciones desde que se empezó a buscar
+uint64_t lifeCycleRecordStart = 0;     // Hash del tablero al empezar a grabar
+int lifeCyclePeriod = 0;
+int lifeCyclePhase = 0;
+size_t lifeCycleRecordedTiles = 0;
+vector<LifeCycleFrame> lifeCycleFrames;
+
+// Paso de mezcla de una fila en la cadena de su tesela (suma, rotación y XOR,
+// más barato que multiplicar en cada palabra)
+LIFE_INLINE uint64_t lifeHashRow(uint64_t lane, uint64_t word) {
+    lane += word;
+    lane ^= (lane << 23) | (lane >> 41);
+    return lane + ((lane << 7) | (lane >> 57));
+}
+
+// Hashes de todas las teselas de la banda ty, distintos para cada posición. Las
+// filas se recorren en orden y alternan entre cuatro cadenas por tesela, así que
+// el ciclo interno avanza por palabras contiguas y se puede vectorizar; solo la
+// mezcla final de cada tesela multiplica.
+void lifeBandHashes(int ty, uint64_t* hashes) {
+    const int cols = lifeTileCols;
+    const int y0 = ty * LIFE_TILE_ROWS;
+    const int y1 = min(y0 + LIFE_TILE_ROWS, universeHeight);
+
+    thread_local vector<uint64_t> lanes;
+    lanes.resize(4 * (size_t)cols);
+    for (int i = 0; i < 4; i++) {
+        for (int tx = 0; tx < cols; tx++) {
+            lanes[i * cols + tx] = ((size_t)ty * cols + tx + 1) * 0x9E3779B97F4A7C15ULL + i;
+        }
+    }
+
+    for (int y = y0; y < y1; y++) {
+        const uint64_t* row = lifeRow(lifeCells, y);
+        uint64_t* lane = &lanes[((y - y0) & 3) * cols];
+        for (int tx = 0; tx < cols - 1; tx++) {
+            lane[tx] = lifeHashRow(lane[tx], row[tx]);
+        }
+        // En un toro la última palabra lleva la primera columna en los bits de relleno
+        lane[cols - 1] = lifeHashRow(lane[cols - 1], row[cols - 1] & lifeLastWordMask);
+    }
+
+    for (int tx = 0; tx < cols; tx++) {
+        uint64_t hash = lanes[tx];
+        for (int i = 1; i < 4; i++) {
+            hash = (hash ^ lanes[i * cols + tx]) * 0xBF58476D1CE4E5B9ULL;
+            hash ^= hash >> 31;
+        }
+        hash *= 0x94D049BB133111EBULL;
+        hashes[tx] = hash ^ (hash >> 32);
+    }
+}
+
+// Recalcula los hashes de las bandas con teselas sucias y actualiza lifeGridHash
+void updateLifeGridHash() {
+    uint64_t hashDelta = 0;
+
+    lifeParallelFor(lifeTileRows, [&](int ty) {
+        uint8_t* dirty = &lifeTileDirty[(size_t)ty * lifeTileCols];
+        if (find(dirty, dirty + lifeTileCols, 1) == dirty + lifeTileCols) {
+            return;
+        }
+        uint64_t* hashes = &lifeTileHashes[(size_t)ty * lifeTileCols];
+        thread_local vector<uint64_t> band;
+        band.resize(lifeTileCols);
+        lifeBandHashes(ty, band.data());
+        uint64_t bandDelta = 0;
+        for (int tx = 0; tx < lifeTileCols; tx++) {
+            bandDelta ^= hashes[tx] ^ band[tx];
+            hashes[tx] = band[tx];
+        }
+        memset(dirty, 0, lifeTileCols);
+        #pragma omp atomic
+        hashDelta ^= bandDelta;
+    });
+
+    lifeGridHash ^= hashDelta;
+}
+
+// Vuelve a buscar desde cero con el tablero actual
+void resetLifeCycle() {
+    size_t tiles = (size_t)lifeTileCols * lifeTileRows;
+    lifeTileHashes.assign(tiles, 0);
+    lifeTileDirty.assign(tiles, 1);
+    lifeGridHash = 0;
+    updateLifeGridHash();
+
+    if (lifeCycleState == LIFE_CYCLE_REPLAYING) {
+        // La próxima generación normal calcula todo el tablero (las copias de la
+        // repetición no mantienen el segundo búfer)
+        fill(lifeTileChanged.begin(), lifeTileChanged.end(), 1);
+    }
+    lifeCycleState = LIFE_CYCLE_SEARCHING;
+    lifeCycleHistory.assign(lifeCycleMaxPeriod + 1, 0);
+    lifeCycleHistory[0] = lifeGridHash;
+    lifeCycleSteps = 0;
+    lifeCycleFrames.clear();
+    lifeCycleRecordedTiles = 0;
+}
+
+// Anota la generación recién calculada: marca sus teselas sucias y, cada
+// LIFE_CYCLE_SAMPLE generaciones, busca el hash entre las muestras anteriores
+void recordLifeCycleStep() {
+    const size_t tiles = lifeTileDirty.size();
+    for (size_t tile = 0; tile < tiles; tile++) {
+        lifeTileDirty[tile] |= lifeTileChanged[tile];
+    }
+    lifeCycleSteps++;
+
+    if (lifeCycleState == LIFE_CYCLE_RECORDING) {
+        LifeCycleFrame frame;
+        frame.births = lifeBirths;
+        frame.deaths = lifeDeaths;
+        for (size_t tile = 0; tile < tiles; tile++) {
+            if (!lifeTileChanged[tile]) {
+                continue;
+            }
+            int ty = tile / lifeTileCols;
+            int tx = tile % lifeTileCols;
+            int y1 = min((ty + 1) * LIFE_TILE_ROWS, universeHeight);
+            for (int y = ty * LIFE_TILE_ROWS; y < y1; y++) {
+                frame.words.push_back(lifeRow(lifeCells, y)[tx]);
+            }
+            frame.tiles.push_back(tile);
+        }
+        lifeCycleRecordedTiles += frame.tiles.size();
+        lifeCycleFrames.push_back(move(frame));
+
+        if (lifeCycleRecordedTiles > LIFE_CYCLE_MAX_RECORDED_TILES) {
+            resetLifeCycle();
+            return;
+        }
+
+        const int recorded = lifeCycleFrames.size();
+        updateLifeGridHash();
+        if (lifeGridHash == lifeCycleRecordStart && lifeCyclePeriod % recorded == 0) {
+            lifeCyclePeriod = recorded;
+            lifeCycleState = LIFE_CYCLE_REPLAYING;
+            lifeCyclePhase = 0;
+        } else if (recorded == lifeCyclePeriod) {
+            resetLifeCycle();
+        }
+        return;
+    }
+
+    if (lifeCycleSteps % LIFE_CYCLE_SAMPLE != 0) {
+        return;
+    }
+    updateLifeGridHash();
+
+    const uint64_t ring = lifeCycleHistory.size();
+    const uint64_t sample = lifeCycleSteps / LIFE_CYCLE_SAMPLE;
+    uint64_t known = min<uint64_t>(sample, lifeCycleMaxPeriod);
+    for (uint64_t back = 1; back <= known; back++) {
+        if (lifeCycleHistory[(sample - back) % ring] == lifeGridHash) {
+            lifeCycleState = LIFE_CYCLE_RECORDING;
+            lifeCyclePeriod = back * LIFE_CYCLE_SAMPLE;
+            lifeCycleRecordStart = lifeGridHash;
+            lifeCycleFrames.clear();
+            lifeCycleRecordedTiles = 0;
+            break;
+        }
+    }
+    lifeCycleHistory[sample % ring] = lifeGridHash;
+}
+
+// Avanza una generación copiando las teselas grabadas de la fase actual
+void replayLifeCycle() {
+    const LifeCycleFrame& frame = lifeCycleFrames[lifeCyclePhase];
+    fill(lifeTileChanged.begin(), lifeTileChanged.end(), 0);
+
+    size_t word = 0;
+    for (uint32_t tile : frame.tiles) {
+        int ty = tile / lifeTileCols;
+        int tx = tile % lifeTileCols;
+        int y1 = min((ty + 1) * LIFE_TILE_ROWS, universeHeight);
+        for (int y = ty * LIFE_TILE_ROWS; y < y1; y++) {
+            lifeRow(lifeCells, y)[tx] = frame.words[word++];
+        }
+        lifeTileChanged[tile] = 1;
+    }
+    lifeBirths = frame.births;
+    lifeDeaths = frame.deaths;
+    lifeActiveTiles = frame.tiles.size();
+
+    lifeCyclePhase = (lifeCyclePhase + 1) % lifeCyclePeriod;
+    colorizeChangedTiles();
+}
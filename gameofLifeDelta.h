@@ -0,0 +1,169 @@
+// Motor por listas de cambios: cada célula guarda su estado y la cantidad de vecinos
+// vivos, y esa cuenta solo se actualiza alrededor de las células que cambiaron. En
+// cada generación la regla se evalúa solo sobre las células candidatas (las que
+// cambiaron o tienen una vecina que cambió), y la lista de células que cambiaron
+// dice también qué píxeles hay que volver a pintar. Conviene cuando cambia una
+// fracción pequeña del tablero por generación. Como en HashLife, mientras este
+// motor manda el tablero de bits no se actualiza. Se incluye desde gameofLife.h.
+
+// Cada byte: bits 0-3 vecinos vivos, bit 4 viva, bit 5 ya está en la lista de candidatas
+const uint8_t LIFE_DELTA_COUNT = 0x0F;
+const uint8_t LIFE_DELTA_ALIVE = 0x10;
+const uint8_t LIFE_DELTA_QUEUED = 0x20;
+
+vector<uint8_t> lifeDeltaCells;
+// Células como (y << 16) | x, que alcanza para LIFE_MAX_DIMENSION
+vector<uint32_t> lifeDeltaCandidates;
+vector<uint32_t> lifeDeltaFlips;
+bool lifeDeltaLoaded = false;
+
+inline uint32_t lifeDeltaKey(int x, int y) {
+    return ((uint32_t)y << 16) | (uint32_t)x;
+}
+
+// Agrega la célula a las candidatas de la próxima generación si no estaba ya
+inline void lifeDeltaQueue(uint32_t key, size_t index) {
+    if (!(lifeDeltaCells[index] & LIFE_DELTA_QUEUED)) {
+        lifeDeltaCells[index] |= LIFE_DELTA_QUEUED;
+        lifeDeltaCandidates.push_back(key);
+    }
+}
+
+// Recorre las ocho vecinas de (x, y) según lifeBoundary
+template <typename Visit>
+inline void lifeDeltaForEachNeighbor(int x, int y, Visit visit) {
+    bool wrap = lifeBoundary == LIFE_BOUNDARY_WRAP;
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if (!dx && !dy) {
+                continue;
+            }
+            int nx = x + dx;
+            int ny = y + dy;
+            if (wrap) {
+                nx = (nx + universeWidth) % universeWidth;
+                ny = (ny + universeHeight) % universeHeight;
+            } else if (nx < 0 || nx >= universeWidth || ny < 0 || ny >= universeHeight) {
+                continue;
+            }
+            visit(nx, ny);
+        }
+    }
+}
+
+// Arma estados y cuentas desde el tablero de bits; todas las células vivas y sus
+// vecinas quedan como candidatas
+void lifeDeltaImport() {
+    lifeDeltaCells.assign((size_t)universeWidth * universeHeight, 0);
+    lifeDeltaCandidates.clear();
+
+    for (int y = 0; y < universeHeight; y++) {
+        const uint64_t* row = lifeRow(lifeCells, y);
+        for (int k = 0; k < lifeWordsPerRow; k++) {
+            uint64_t word = row[k] & (k == lifeWordsPerRow - 1 ? lifeLastWordMask : ~0ULL);
+            while (word) {
+                int x = k * LIFE_WORD_BITS + __builtin_ctzll(word);
+                word &= word - 1;
+
+                size_t index = (size_t)y * universeWidth + x;
+                lifeDeltaCells[index] |= LIFE_DELTA_ALIVE;
+                lifeDeltaQueue(lifeDeltaKey(x, y), index);
+                lifeDeltaForEachNeighbor(x, y, [&](int nx, int ny) {
+                    size_t neighbor = (size_t)ny * universeWidth + nx;
+                    lifeDeltaCells[neighbor]++;
+                    lifeDeltaQueue(lifeDeltaKey(nx, ny), neighbor);
+                });
+            }
+        }
+    }
+
+    lifeDeltaLoaded = true;
+    lifeGridEdited = false;
+}
+
+void lifeDeltaExport() {
+    memset(lifeCells, 0, lifeWords * sizeof(uint64_t));
+    for (int y = 0; y < universeHeight; y++) {
+        const uint8_t* cells = &lifeDeltaCells[(size_t)y * universeWidth];
+        uint64_t* row = lifeRow(lifeCells, y);
+        for (int x = 0; x < universeWidth; x++) {
+            row[x / LIFE_WORD_BITS] |= (uint64_t)((cells[x] & LIFE_DELTA_ALIVE) != 0) << (x % LIFE_WORD_BITS);
+        }
+    }
+
+    markAllLifeTilesChanged();
+    lifeGridEdited = false;
+}
+
+// Avanza una generación y pinta las células que cambiaron, ampliando lifeDirtyRect
+void lifeDeltaStep() {
+    // Próximo estado según el estado y la cuenta (los cinco bits bajos de la célula)
+    uint8_t rule[32];
+    for (int i = 0; i < 32; i++) {
+        int neighbors = i & LIFE_DELTA_COUNT;
+        int mask = (i & LIFE_DELTA_ALIVE) ? lifeRuleSurvive : lifeRuleBirth;
+        rule[i] = neighbors <= 8 && ((mask >> neighbors) & 1) ? LIFE_DELTA_ALIVE : 0;
+    }
+
+    // Primero se decide qué cambia con las cuentas viejas, después se aplica
+    lifeDeltaFlips.clear();
+    for (uint32_t key : lifeDeltaCandidates) {
+        size_t index = (size_t)(key >> 16) * universeWidth + (key & 0xFFFF);
+        uint8_t cell = lifeDeltaCells[index] & ~LIFE_DELTA_QUEUED;
+        lifeDeltaCells[index] = cell;
+        if (rule[cell & 0x1F] != (cell & LIFE_DELTA_ALIVE)) {
+            lifeDeltaFlips.push_back(key);
+        }
+    }
+
+    int x0 = lifeDirtyRect.x, y0 = lifeDirtyRect.y;
+    int x1 = x0 + lifeDirtyRect.w, y1 = y0 + lifeDirtyRect.h;
+    if (lifeDirtyRect.w == 0) {
+        x0 = RENDER_WIDTH, y0 = RENDER_HEIGHT, x1 = 0, y1 = 0;
+    }
+
+    lifeDeltaCandidates.clear();
+    for (uint32_t key : lifeDeltaFlips) {
+        int x = key & 0xFFFF;
+        int y = key >> 16;
+        size_t index = (size_t)y * universeWidth + x;
+        lifeDeltaCells[index] ^= LIFE_DELTA_ALIVE;
+        bool alive = lifeDeltaCells[index] & LIFE_DELTA_ALIVE;
+        (alive ? lifeBirths : lifeDeaths)++;
+
+        // La propia célula puede volver a cambiar aunque su cuenta no cambie
+        lifeDeltaQueue(key, index);
+        lifeDeltaForEachNeighbor(x, y, [&](int nx, int ny) {
+            size_t neighbor = (size_t)ny * universeWidth + nx;
+            lifeDeltaCells[neighbor] += alive ? 1 : -1;
+            lifeDeltaQueue(lifeDeltaKey(nx, ny), neighbor);
+        });
+
+        int pixelX = x - lifeViewX;
+        int pixelY = y - lifeViewY;
+        if (pixelX >= 0 && pixelX < RENDER_WIDTH && pixelY >= 0 && pixelY < RENDER_HEIGHT) {
+            framebuffer[pixelY * RENDER_WIDTH + pixelX] = alive ? aliveColor : deadColor;
+            x0 = min(x0, pixelX);
+            y0 = min(y0, pixelY);
+            x1 = max(x1, pixelX + 1);
+            y1 = max(y1, pixelY + 1);
+        }
+    }
+
+    lifeDirtyRect = (x1 > x0) ? SDL_Rect{ x0, y0, x1 - x0, y1 - y0 } : SDL_Rect{ 0, 0, 0, 0 };
+}
+
+// Avanza lifeTemporalBlock generaciones; lifeDirtyRect cubre los píxeles que
+// cambiaron en cualquiera de ellas
+void updateGameOfLifeDelta() {
+    lifeDirtyRect = { 0, 0, 0, 0 };
+    if (!lifeDeltaLoaded || lifeGridEdited) {
+        lifeDeltaImport();
+        colorizeLifeRegion(0, 0, RENDER_WIDTH, RENDER_HEIGHT);
+        lifeDirtyRect = { 0, 0, RENDER_WIDTH, RENDER_HEIGHT };
+    }
+
+    for (int i = 0; i < lifeTemporalBlock; i++) {
+        lifeDeltaStep();
+    }
+}
@@ -0,0 +1,109 @@
+// Hilo de simulación con entrega de cuadros por triple buffer. La simulación
+// corre en su propio hilo, a lifeSimulationRate generaciones por segundo, y tras
+// cada generación copia el framebuffer y las estadísticas en un cuadro. De los
+// tres cuadros, uno lo escribe la simulación, otro lo lee el hilo que dibuja y
+// el tercero es el último publicado; publicar y tomar cambian el índice propio
+// por el del medio con un solo exchange atómico, así que ninguno de los dos
+// espera al otro y cada uno avanza a su ritmo: el dibujo siempre toma la
+// generación más reciente y se saltea las que no alcanzó a mostrar.
+// Se incluye desde gameofLife.h.
+
+// Generaciones por segundo del hilo de simulación (--sim-rate, 0 = sin límite)
+double lifeSimulationRate = 60;
+
+struct LifeFrame {
+    vector<Color> pixels;  // Copia completa del framebuffer
+    SDL_Rect dirty;        // Región que cambió respecto del cuadro publicado antes
+    uint64_t sequence;     // Número del cuadro: si el anterior se salteó, dirty no alcanza
+    LifeStats stats;
+};
+
+// Bit del índice del medio que indica que se publicó y nadie lo tomó todavía
+const uint32_t LIFE_FRAME_FRESH = 4;
+
+LifeFrame lifeFrames[3];
+atomic<uint32_t> lifeFrameMiddle(1);
+int lifeFrameBack = 0;   // Solo lo usa la simulación
+int lifeFrameFront = 2;  // Solo lo usa el hilo que dibuja
+uint64_t lifeFrameSequence = 0;
+
+thread lifeSimulationThread;
+atomic<bool> lifeSimulationRunning(false);
+
+// Copia la generación actual en el cuadro propio y lo publica. Se llama desde
+// el hilo de simulación (o antes de crearlo, para el cuadro inicial).
+void publishLifeFrame() {
+    LifeFrame& frame = lifeFrames[lifeFrameBack];
+    frame.pixels.assign(framebuffer, framebuffer + FRAMEBUFFER_SIZE);
+    frame.dirty = lifeDirtyRect;
+    frame.sequence = ++lifeFrameSequence;
+    frame.stats = getLifeStats();
+
+    // release: quien lo tome ve el cuadro escrito; acquire: el que se recibe a
+    // cambio ya no lo está leyendo el hilo que dibuja
+    uint32_t previous = lifeFrameMiddle.exchange(lifeFrameBack | LIFE_FRAME_FRESH, memory_order_acq_rel);
+    lifeFrameBack = previous & ~LIFE_FRAME_FRESH;
+}
+
+// Toma el último cuadro publicado; nullptr si no hay uno nuevo desde la vez
+// anterior. El cuadro es del que llama hasta la próxima llamada.
+const LifeFrame* takeLifeFrame() {
+    // Solo la simulación cambia el del medio, y siempre lo deja marcado como nuevo
+    if (!(lifeFrameMiddle.load(memory_order_relaxed) & LIFE_FRAME_FRESH)) {
+        return nullptr;
+    }
+    uint32_t previous = lifeFrameMiddle.exchange(lifeFrameFront, memory_order_acq_rel);
+    lifeFrameFront = previous & ~LIFE_FRAME_FRESH;
+    return &lifeFrames[lifeFrameFront];
+}
+
+void runLifeSimulation() {
+    // Un equipo para todo el hilo: el maestro avanza y publica las generaciones
+    // y los demás toman, desde la barrera final, las tareas de lifeParallelFor
+    #pragma omp parallel
+    {
+        pinLifeThread();
+
+        #pragma omp master
+        {
+            typedef chrono::steady_clock Clock;
+            Clock::time_point next = Clock::now();
+            while (lifeSimulationRunning.load(memory_order_acquire)) {
+                updateGameOfLife();
+                publishLifeFrame();
+
+                if (lifeSimulationRate > 0) {
+                    next += chrono::duration_cast<Clock::duration>(chrono::duration<double>(1.0 / lifeSimulationRate));
+                    // Atrasada, sigue desde ahora en lugar de recuperar de golpe
+                    if (next < Clock::now()) {
+                        next = Clock::now();
+                    }
+                    // En tramos cortos, para que un ritmo lento no demore la salida
+                    while (lifeSimulationRunning.load(memory_order_acquire) && Clock::now() < next) {
+                        this_thread::sleep_for(min<Clock::duration>(next - Clock::now(), chrono::milliseconds(10)));
+                    }
+                }
+            }
+
+            // PR_SET_PDEATHSIG mata a los trabajadores cuando termina el hilo que
+            // los creó, así que se detienen aquí en orden
+            stopLifeWorkers();
+        }
+    }
+}
+
+// Publica el estado actual como primer cuadro y arranca la simulación
+void startLifeSimulation() {
+    publishLifeFrame();
+    lifeSimulationRunning.store(true, memory_order_release);
+    lifeSimulationThread = thread(runLifeSimulation);
+}
+
+// Detiene la simulación al terminar la generación en curso; después el
+// tablero queda quieto y se puede guardar
+void stopLifeSimulation() {
+    if (lifeSimulationThread.joinable()) {
+        lifeSimulationRunning.store(false, memory_order_release);
+        lifeSimulationThread.join();
+    }
+}
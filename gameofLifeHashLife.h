@@ -0,0 +1,456 @@
+// Motor HashLife (algoritmo de Gosper) para universos muy grandes o corridas muy largas.
+//
+// El universo se guarda como un quadtree: un nodo de nivel L es un cuadrado de
+// 2^L x 2^L células formado por cuatro hijos de nivel L - 1 (en el nivel 0 los
+// nodos son células: el id 0 es una célula muerta y el id 1 una viva). Los
+// nodos son canónicos (hash-consing): dos regiones iguales comparten el mismo
+// nodo, y cada nodo memoriza su centro avanzado 2^k generaciones, así que los
+// patrones regulares como las guns se calculan una sola vez.
+//
+// A diferencia del tablero de bits, el plano es infinito: los bordes del
+// universo solo indican qué región se importa y se exporta.
+
+const uint32_t HASHLIFE_NONE = 0xFFFFFFFF;
+
+// Los bloques de 64x64 (nivel 6) coinciden con 64 palabras del tablero de bits
+const int HASHLIFE_BLOCK_LEVEL = 6;
+
+struct HashLifeNode {
+    uint32_t nw, ne, sw, se;  // Hijos (en el nivel 1 son células)
+    uint32_t next;            // Centro avanzado 2^k generaciones, o HASHLIFE_NONE
+    uint32_t level;
+    uint64_t population;
+};
+
+vector<HashLifeNode> hashLifeNodes;
+vector<uint32_t> hashLifeTable;   // Tabla hash de direccionamiento abierto con ids de nodos
+vector<uint32_t> hashLifeEmpty;   // Nodo vacío canónico de cada nivel
+uint32_t hashLifeRoot = HASHLIFE_NONE;
+
+// Cada paso avanza 2^hashLifeStepLog generaciones (--hashlife-step). Los
+// resultados memorizados son de pasos de 2^hashLifeMemoStepLog, que es menor
+// si el paso pedido no cupo en el límite de memoria (ver hashLifeStep).
+int hashLifeStepLog = 0;
+int hashLifeMemoStepLog = -1;
+int hashLifeFallbackStepLog = 64;
+
+// Límite de memoria para los nodos (--hashlife-memory). hashLifeJoin marca
+// hashLifeOverflow al alcanzarlo y el paso en curso se abandona para recolectar
+// los nodos que no son alcanzables desde la raíz.
+size_t hashLifeMemoryMB = 1024;
+size_t hashLifeNodeLimit = SIZE_MAX;
+bool hashLifeOverflow = false;
+
+// Coordenadas del universo que corresponden a la coordenada (0, 0) del árbol.
+// Son múltiplos de 64 para que los bloques del árbol caigan sobre palabras completas.
+// La raíz de nivel L cubre [-2^(L-1), 2^(L-1)) en ambos ejes.
+int64_t hashLifeOriginX = 0;
+int64_t hashLifeOriginY = 0;
+
+inline size_t hashLifeHash(uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se) {
+    uint64_t h = nw * 0x9E3779B97F4A7C15ULL;
+    h = (h ^ ne) * 0xC2B2AE3D27D4EB4FULL;
+    h = (h ^ sw) * 0x165667B19E3779F9ULL;
+    h = (h ^ se) * 0x27D4EB2F165667C5ULL;
+    return h ^ (h >> 29);
+}
+
+// Cada nodo ocupa su estructura más dos entradas de la tabla hash
+const size_t HASHLIFE_NODE_BYTES = sizeof(HashLifeNode) + 2 * sizeof(uint32_t);
+
+// Los ids son de 32 bits y HASHLIFE_NONE no puede ser un nodo: con más memoria
+// que esta no caben más nodos
+const size_t HASHLIFE_MAX_MEMORY_MB = size_t(HASHLIFE_NONE) * HASHLIFE_NODE_BYTES / (1024 * 1024);
+
+size_t hashLifeMaxNodes() {
+    return min<size_t>(hashLifeMemoryMB * 1024 * 1024 / HASHLIFE_NODE_BYTES, HASHLIFE_NONE - 1);
+}
+
+void hashLifeInsert(uint32_t id) {
+    const HashLifeNode& node = hashLifeNodes[id];
+    size_t mask = hashLifeTable.size() - 1;
+    size_t slot = hashLifeHash(node.nw, node.ne, node.sw, node.se) & mask;
+    while (hashLifeTable[slot] != HASHLIFE_NONE) {
+        slot = (slot + 1) & mask;
+    }
+    hashLifeTable[slot] = id;
+}
+
+// Duplica la tabla hash cuando pasa del 50 % de ocupación
+void hashLifeGrowTable() {
+    hashLifeTable.assign(hashLifeTable.size() * 2, HASHLIFE_NONE);
+    for (uint32_t id = 2; id < hashLifeNodes.size(); id++) {
+        hashLifeInsert(id);
+    }
+}
+
+// Devuelve el nodo canónico con esos cuatro hijos, creándolo si no existe
+uint32_t hashLifeJoin(uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se) {
+    size_t mask = hashLifeTable.size() - 1;
+    size_t slot = hashLifeHash(nw, ne, sw, se) & mask;
+
+    while (hashLifeTable[slot] != HASHLIFE_NONE) {
+        const HashLifeNode& node = hashLifeNodes[hashLifeTable[slot]];
+        if (node.nw == nw && node.ne == ne && node.sw == sw && node.se == se) {
+            return hashLifeTable[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    uint32_t level = hashLifeNodes[nw].level + 1;
+    uint64_t population = hashLifeNodes[nw].population + hashLifeNodes[ne].population +
+                          hashLifeNodes[sw].population + hashLifeNodes[se].population;
+    uint32_t id = hashLifeNodes.size();
+    hashLifeNodes.push_back({ nw, ne, sw, se, HASHLIFE_NONE, level, population });
+    hashLifeTable[slot] = id;
+    if (hashLifeNodes.size() >= hashLifeNodeLimit) {
+        hashLifeOverflow = true;
+    }
+
+    if (hashLifeNodes.size() * 2 > hashLifeTable.size()) {
+        hashLifeGrowTable();
+    }
+    return id;
+}
+
+uint32_t hashLifeEmptyNode(int level) {
+    while ((int)hashLifeEmpty.size() <= level) {
+        uint32_t child = hashLifeEmpty.back();
+        hashLifeEmpty.push_back(hashLifeJoin(child, child, child, child));
+    }
+    return hashLifeEmpty[level];
+}
+
+// Deja el árbol vacío, con solo las dos células del nivel 0
+void hashLifeClear() {
+    hashLifeNodes.clear();
+    hashLifeNodes.push_back({ 0, 0, 0, 0, HASHLIFE_NONE, 0, 0 });
+    hashLifeNodes.push_back({ 0, 0, 0, 0, HASHLIFE_NONE, 0, 1 });
+    hashLifeTable.assign(1 << 16, HASHLIFE_NONE);
+    hashLifeEmpty.assign(1, 0);
+    hashLifeRoot = HASHLIFE_NONE;
+    hashLifeMemoStepLog = -1;
+}
+
+// Cuadrado centrado de nivel L - 1 dentro de un nodo de nivel L
+uint32_t hashLifeCentre(uint32_t id) {
+    HashLifeNode n = hashLifeNodes[id];
+    return hashLifeJoin(hashLifeNodes[n.nw].se, hashLifeNodes[n.ne].sw,
+                        hashLifeNodes[n.sw].ne, hashLifeNodes[n.se].nw);
+}
+
+// Caso base: un nodo de 4x4 células devuelve su centro de 2x2 una generación después
+uint32_t hashLifeBase(uint32_t id) {
+    HashLifeNode n = hashLifeNodes[id];
+    const HashLifeNode* q[4] = { &hashLifeNodes[n.nw], &hashLifeNodes[n.ne], &hashLifeNodes[n.sw], &hashLifeNodes[n.se] };
+
+    // Células del bloque de 4x4 por fila y columna
+    int cells[4][4];
+    for (int i = 0; i < 4; i++) {
+        int ox = (i % 2) * 2;
+        int oy = (i / 2) * 2;
+        cells[oy][ox] = q[i]->nw;
+        cells[oy][ox + 1] = q[i]->ne;
+        cells[oy + 1][ox] = q[i]->sw;
+        cells[oy + 1][ox + 1] = q[i]->se;
+    }
+
+    // Cada célula central se resuelve con la función de transición de la regla activa
+    uint32_t result[4];
+    for (int i = 0; i < 4; i++) {
+        int x = 1 + i % 2;
+        int y = 1 + i / 2;
+        int neighborhood = 0;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                neighborhood |= cells[y + dy][x + dx] << ((dy + 1) * 3 + (dx + 1));
+            }
+        }
+        result[i] = lifeTransition[neighborhood];
+    }
+
+    return hashLifeJoin(result[0], result[1], result[2], result[3]);
+}
+
+// Centro de un nodo de nivel L avanzado 2^min(hashLifeMemoStepLog, L - 2)
+// generaciones. El resultado se memoriza en el nodo. Si se llega al límite de
+// memoria devuelve HASHLIFE_NONE sin memorizar nada en los nodos sin terminar.
+uint32_t hashLifeSuccessor(uint32_t id) {
+    if (hashLifeNodes[id].next != HASHLIFE_NONE) {
+        return hashLifeNodes[id].next;
+    }
+
+    HashLifeNode n = hashLifeNodes[id];
+    uint32_t result;
+
+    if (n.population == 0) {
+        result = hashLifeEmptyNode(n.level - 1);
+    } else if (n.level == 2) {
+        result = hashLifeBase(id);
+    } else {
+        HashLifeNode nw = hashLifeNodes[n.nw], ne = hashLifeNodes[n.ne];
+        HashLifeNode sw = hashLifeNodes[n.sw], se = hashLifeNodes[n.se];
+
+        // Nueve subcuadrados de nivel L - 1 que se solapan a medias
+        uint32_t sub[9] = {
+            n.nw,
+            hashLifeJoin(nw.ne, ne.nw, nw.se, ne.sw),
+            n.ne,
+            hashLifeJoin(nw.sw, nw.se, sw.nw, sw.ne),
+            hashLifeJoin(nw.se, ne.sw, sw.ne, se.nw),
+            hashLifeJoin(ne.sw, ne.se, se.nw, se.ne),
+            n.sw,
+            hashLifeJoin(sw.ne, se.nw, sw.se, se.sw),
+            n.se
+        };
+
+        // A velocidad completa cada mitad del salto avanza 2^(L-3); si el paso
+        // es más corto, la primera mitad solo recorta el centro sin avanzar
+        bool fullSpeed = hashLifeMemoStepLog >= (int)n.level - 2;
+        uint32_t r[9];
+        for (int i = 0; i < 9; i++) {
+            r[i] = fullSpeed ? hashLifeSuccessor(sub[i]) : hashLifeCentre(sub[i]);
+            if (hashLifeOverflow) {
+                return HASHLIFE_NONE;
+            }
+        }
+
+        uint32_t c[4] = {
+            hashLifeJoin(r[0], r[1], r[3], r[4]),
+            hashLifeJoin(r[1], r[2], r[4], r[5]),
+            hashLifeJoin(r[3], r[4], r[6], r[7]),
+            hashLifeJoin(r[4], r[5], r[7], r[8])
+        };
+        for (int i = 0; i < 4; i++) {
+            c[i] = hashLifeSuccessor(c[i]);
+            if (hashLifeOverflow) {
+                return HASHLIFE_NONE;
+            }
+        }
+        result = hashLifeJoin(c[0], c[1], c[2], c[3]);
+    }
+
+    hashLifeNodes[id].next = result;
+    return result;
+}
+
+// Rodea la raíz con un anillo vacío, subiendo un nivel sin mover el centro
+uint32_t hashLifeExpand(uint32_t id) {
+    HashLifeNode n = hashLifeNodes[id];
+    uint32_t e = hashLifeEmptyNode(n.level - 1);
+    return hashLifeJoin(hashLifeJoin(e, e, e, n.nw), hashLifeJoin(e, e, n.ne, e),
+                        hashLifeJoin(e, n.sw, e, e), hashLifeJoin(n.se, e, e, e));
+}
+
+// Copia un nodo (y sus descendientes) al árbol nuevo durante la recolección
+uint32_t hashLifeCopy(uint32_t id, const vector<HashLifeNode>& oldNodes, vector<uint32_t>& remap) {
+    if (id < 2) {
+        return id;
+    }
+    if (remap[id] == HASHLIFE_NONE) {
+        const HashLifeNode& n = oldNodes[id];
+        uint32_t nw = hashLifeCopy(n.nw, oldNodes, remap);
+        uint32_t ne = hashLifeCopy(n.ne, oldNodes, remap);
+        uint32_t sw = hashLifeCopy(n.sw, oldNodes, remap);
+        uint32_t se = hashLifeCopy(n.se, oldNodes, remap);
+        remap[id] = hashLifeJoin(nw, ne, sw, se);
+    }
+    return remap[id];
+}
+
+// Recolección de basura: conserva solo los nodos alcanzables desde la raíz y
+// descarta los resultados memorizados
+void hashLifeCollect() {
+    vector<HashLifeNode> oldNodes;
+    oldNodes.swap(hashLifeNodes);
+    vector<uint32_t> remap(oldNodes.size(), HASHLIFE_NONE);
+    uint32_t oldRoot = hashLifeRoot;
+
+    hashLifeClear();
+    hashLifeRoot = hashLifeCopy(oldRoot, oldNodes, remap);
+}
+
+// Construye el nodo de nivel "level" cuya esquina está en (x, y) dentro de un
+// bloque de 64x64 células (una palabra por fila)
+uint32_t hashLifeBuildBlock(const uint64_t* rows, int x, int y, int level) {
+    if (level == 0) {
+        return (rows[y] >> x) & 1;
+    }
+
+    int size = 1 << level;
+    uint64_t mask = (size == 64) ? ~0ULL : ((1ULL << size) - 1) << x;
+    bool empty = true;
+    for (int r = y; r < y + size && empty; r++) {
+        empty = (rows[r] & mask) == 0;
+    }
+    if (empty) {
+        return hashLifeEmptyNode(level);
+    }
+
+    int half = size / 2;
+    return hashLifeJoin(hashLifeBuildBlock(rows, x, y, level - 1), hashLifeBuildBlock(rows, x + half, y, level - 1),
+                        hashLifeBuildBlock(rows, x, y + half, level - 1), hashLifeBuildBlock(rows, x + half, y + half, level - 1));
+}
+
+// Construye el nodo del cuadrado del árbol con esquina (treeX, treeY) a partir del tablero de bits
+uint32_t hashLifeBuildRegion(int64_t treeX, int64_t treeY, int level) {
+    int64_t size = 1LL << level;
+    int64_t x0 = treeX + hashLifeOriginX;
+    int64_t y0 = treeY + hashLifeOriginY;
+    if (x0 >= universeWidth || y0 >= universeHeight || x0 + size <= 0 || y0 + size <= 0) {
+        return hashLifeEmptyNode(level);
+    }
+
+    if (level == HASHLIFE_BLOCK_LEVEL) {
+        int k = x0 / LIFE_WORD_BITS;
+        uint64_t mask = (k == lifeWordsPerRow - 1) ? lifeLastWordMask : ~0ULL;
+        uint64_t rows[64];
+        for (int r = 0; r < 64; r++) {
+            int64_t y = y0 + r;
+            rows[r] = (y >= 0 && y < universeHeight) ? lifeRow(lifeCells, y)[k] & mask : 0;
+        }
+        return hashLifeBuildBlock(rows, 0, 0, HASHLIFE_BLOCK_LEVEL);
+    }
+
+    int64_t half = size / 2;
+    return hashLifeJoin(hashLifeBuildRegion(treeX, treeY, level - 1), hashLifeBuildRegion(treeX + half, treeY, level - 1),
+                        hashLifeBuildRegion(treeX, treeY + half, level - 1), hashLifeBuildRegion(treeX + half, treeY + half, level - 1));
+}
+
+// Importa el tablero de bits al árbol
+void hashLifeImport() {
+    hashLifeClear();
+
+    hashLifeOriginX = (universeWidth / 2) / LIFE_WORD_BITS * LIFE_WORD_BITS;
+    hashLifeOriginY = (universeHeight / 2) / LIFE_WORD_BITS * LIFE_WORD_BITS;
+
+    int level = HASHLIFE_BLOCK_LEVEL + 1;
+    while ((1LL << (level - 1)) < max(hashLifeOriginX, universeWidth - hashLifeOriginX) ||
+           (1LL << (level - 1)) < max(hashLifeOriginY, universeHeight - hashLifeOriginY)) {
+        level++;
+    }
+
+    int64_t half = 1LL << (level - 1);
+    hashLifeRoot = hashLifeBuildRegion(-half, -half, level);
+    lifeGridEdited = false;
+}
+
+// Recorre el árbol llamando a visit(x, y) por cada célula viva del rectángulo
+// [x0, x1) x [y0, y1) en coordenadas del árbol; salta los nodos vacíos
+template <typename Visit>
+void hashLifeForEachAlive(uint32_t id, int64_t treeX, int64_t treeY, int64_t x0, int64_t y0, int64_t x1, int64_t y1, Visit& visit) {
+    const HashLifeNode& n = hashLifeNodes[id];
+    int64_t size = 1LL << n.level;
+    if (n.population == 0 || treeX >= x1 || treeY >= y1 || treeX + size <= x0 || treeY + size <= y0) {
+        return;
+    }
+    if (n.level == 0) {
+        visit(treeX, treeY);
+        return;
+    }
+
+    int64_t half = size / 2;
+    uint32_t nw = n.nw, ne = n.ne, sw = n.sw, se = n.se;
+    hashLifeForEachAlive(nw, treeX, treeY, x0, y0, x1, y1, visit);
+    hashLifeForEachAlive(ne, treeX + half, treeY, x0, y0, x1, y1, visit);
+    hashLifeForEachAlive(sw, treeX, treeY + half, x0, y0, x1, y1, visit);
+    hashLifeForEachAlive(se, treeX + half, treeY + half, x0, y0, x1, y1, visit);
+}
+
+int64_t hashLifeRootCorner() {
+    return -(1LL << (hashLifeNodes[hashLifeRoot].level - 1));
+}
+
+// Escribe en el tablero de bits la región del universo (lo que quede fuera se pierde)
+void hashLifeExport() {
+    memset(lifeCells, 0, lifeWords * sizeof(uint64_t));
+
+    auto visit = [](int64_t x, int64_t y) {
+        int64_t cellX = x + hashLifeOriginX;
+        int64_t cellY = y + hashLifeOriginY;
+        lifeRow(lifeCells, cellY)[cellX / LIFE_WORD_BITS] |= 1ULL << (cellX % LIFE_WORD_BITS);
+    };
+    int64_t corner = hashLifeRootCorner();
+    hashLifeForEachAlive(hashLifeRoot, corner, corner, -hashLifeOriginX, -hashLifeOriginY,
+                         universeWidth - hashLifeOriginX, universeHeight - hashLifeOriginY, visit);
+
+    markAllLifeTilesChanged();
+    lifeGridEdited = false;
+}
+
+// Pinta en el framebuffer la región visible, extrayéndola directamente del árbol
+void hashLifeColorize() {
+    fill(framebuffer, framebuffer + FRAMEBUFFER_SIZE, deadColor);
+
+    auto visit = [](int64_t x, int64_t y) {
+        int64_t pixelX = x + hashLifeOriginX - lifeViewX;
+        int64_t pixelY = y + hashLifeOriginY - lifeViewY;
+        framebuffer[pixelY * RENDER_WIDTH + pixelX] = aliveColor;
+    };
+    int64_t corner = hashLifeRootCorner();
+    int64_t viewX = lifeViewX - hashLifeOriginX;
+    int64_t viewY = lifeViewY - hashLifeOriginY;
+    hashLifeForEachAlive(hashLifeRoot, corner, corner, viewX, viewY, viewX + RENDER_WIDTH, viewY + RENDER_HEIGHT, visit);
+
+    lifeDirtyRect = { 0, 0, RENDER_WIDTH, RENDER_HEIGHT };
+}
+
+// Avanza el universo y devuelve cuántas generaciones avanzó: 2^hashLifeStepLog,
+// o menos si un salto tan largo no cabe en el límite de memoria. Al llegar al
+// límite se recolecta (queda la raíz actual, sin resultados memorizados) y se
+// reintenta; si tampoco alcanza, el paso se achica a la mitad y queda así el
+// resto de la sesión. Si ni una generación cabe, el programa termina.
+uint64_t hashLifeStep() {
+    if (hashLifeRoot == HASHLIFE_NONE || lifeGridEdited) {
+        hashLifeImport();
+    }
+
+    hashLifeNodeLimit = hashLifeMaxNodes();
+    int stepLog = min(hashLifeStepLog, hashLifeFallbackStepLog);
+    bool collected = false;
+    while (true) {
+        // Los resultados memorizados dependen del tamaño del paso
+        if (hashLifeMemoStepLog != stepLog) {
+            for (HashLifeNode& node : hashLifeNodes) {
+                node.next = HASHLIFE_NONE;
+            }
+            hashLifeMemoStepLog = stepLog;
+        }
+
+        // La raíz debe tener el patrón dentro de su cuadrado central de nivel L - 2
+        // y ser lo bastante grande para que el salto no alcance sus bordes
+        uint32_t root = hashLifeRoot;
+        while ((int)hashLifeNodes[root].level < stepLog + 3 ||
+               hashLifeNodes[hashLifeCentre(hashLifeCentre(root))].population != hashLifeNodes[root].population) {
+            root = hashLifeExpand(root);
+        }
+
+        hashLifeOverflow = false;
+        uint32_t next = hashLifeSuccessor(root);
+        if (!hashLifeOverflow) {
+            hashLifeRoot = next;
+            break;
+        }
+
+        if (collected) {
+            if (stepLog == 0) {
+                cerr << "HashLife: the live tree does not fit in the " << hashLifeMemoryMB
+                     << " MB memory cap (raise --hashlife-memory)" << endl;
+                exit(1);
+            }
+            if (hashLifeFallbackStepLog > hashLifeStepLog) {
+                cerr << "HashLife: a step of 2^" << stepLog << " generations does not fit in the "
+                     << hashLifeMemoryMB << " MB memory cap; using shorter steps" << endl;
+            }
+            hashLifeFallbackStepLog = --stepLog;
+        }
+        hashLifeCollect();
+        collected = true;
+    }
+
+    return 1ULL << stepLog;
+}
+
+uint64_t hashLifePopulation() {
+    return hashLifeRoot == HASHLIFE_NONE ? 0 : hashLifeNodes[hashLifeRoot].population;
+}
@@ -0,0 +1,139 @@
+// Motor por tablas: cada bloque de 2x2 células se calcula de una sola consulta
+// a partir de su vecindario de 4x4 (16 bits). La tabla de 65536 entradas se
+// arma con cualquier función de transición de 3x3 (512 entradas), así que reglas
+// no totalísticas cuestan lo mismo que Conway. Se incluye desde gameofLife.h.
+
+// Bit (dy + 1) * 3 + (dx + 1) del índice es la célula (x + dx, y + dy); el bit 4 es
+// la propia célula
+const int LIFE_TRANSITION_SIZE = 512;
+
+// Función de transición de 3x3 equivalente a una regla B/S
+vector<uint8_t> lifeRuleTransition(int birth, int survive) {
+    vector<uint8_t> transition(LIFE_TRANSITION_SIZE);
+    for (int i = 0; i < LIFE_TRANSITION_SIZE; i++) {
+        int alive = (i >> 4) & 1;
+        int neighbors = __builtin_popcount(i) - alive;
+        transition[i] = ((alive ? survive : birth) >> neighbors) & 1;
+    }
+    return transition;
+}
+
+vector<uint8_t> lifeTransition = lifeRuleTransition(LIFE_CONWAY_BIRTH, LIFE_CONWAY_SURVIVE);
+
+// La transición depende solo de la cantidad de vecinos: es la de lifeRuleBirth
+// y lifeRuleSurvive, que son las que usan los motores sparse, delta y states
+bool lifeRuleTotalistic = true;
+
+// Resultado de cada vecindario de 4x4: el nibble r es la fila y - 1 + r y su bit c
+// la columna x - 1 + c. Los bits 0 y 1 del resultado son (x, y) y (x + 1, y); los
+// bits 2 y 3 son (x, y + 1) y (x + 1, y + 1). Se arma la primera vez que se usa.
+vector<uint8_t> lifeBlockTable;
+
+void buildLifeBlockTable() {
+    lifeBlockTable.assign(1 << 16, 0);
+
+    for (int block = 0; block < (1 << 16); block++) {
+        uint8_t result = 0;
+        for (int oy = 0; oy < 2; oy++) {
+            for (int ox = 0; ox < 2; ox++) {
+                int neighborhood = 0;
+                for (int r = 0; r < 3; r++) {
+                    neighborhood |= ((block >> ((oy + r) * 4 + ox)) & 7) << (r * 3);
+                }
+                result |= lifeTransition[neighborhood] << (oy * 2 + ox);
+            }
+        }
+        lifeBlockTable[block] = result;
+    }
+}
+
+// Cambia la función de transición; la tabla de bloques se vuelve a armar al usarla.
+// Los kernels del tablero de bits son de reglas B/S, así que el tablero pasa a la
+// tabla de bloques hasta que setLifeRule elija uno.
+void setLifeTransition(const vector<uint8_t>& transition) {
+    lifeTransition = transition;
+    lifeBlockTable.clear();
+    lifeRowKernel = nullptr;
+    lifeRuleTotalistic = false;
+}
+
+// Columnas 64k - 1 .. 64k + 62 de una fila: el bit i es la columna 64k - 1 + i
+LIFE_INLINE uint64_t lifeBlockWindow(const uint64_t* row, int k) {
+    return (row[k] << 1) | (row[k - 1] >> 63);
+}
+
+// Calcula las filas [y0, y1) en las palabras [k0, k1) de dos en dos filas con la
+// tabla de bloques y marca en "changed" las teselas donde alguna célula cambió
+void updateGameOfLifeLutSpan(int y0, int y1, int k0, int k1, uint8_t* changed) {
+    const uint8_t* table = lifeBlockTable.data();
+    thread_local vector<uint64_t> diff;
+    diff.assign(k1 - k0, 0);
+    uint64_t* spanDiff = diff.data();
+    uint64_t births = 0, deaths = 0;
+
+    for (int y = y0; y < y1; y += 2) {
+        // Con una cantidad impar de filas la segunda fila del último par es el halo
+        // inferior: su resultado se descarta y la fila de abajo se repite
+        const uint64_t* rows[4] = {
+            lifeRow(lifeCells, y - 1), lifeRow(lifeCells, y),
+            lifeRow(lifeCells, y + 1), lifeRow(lifeCells, min(y + 2, universeHeight))
+        };
+        const uint64_t* current = rows[1];
+        const uint64_t* currentBelow = rows[2];
+        uint64_t* top = lifeRow(lifeNextCells, y);
+        uint64_t* bottom = lifeRow(lifeNextCells, y + 1);
+        bool pair = y + 1 < y1;
+
+        for (int k = k0; k < k1; k++) {
+            uint64_t window[4];
+            for (int r = 0; r < 4; r++) {
+                window[r] = lifeBlockWindow(rows[r], k);
+            }
+
+            uint64_t outTop = 0, outBottom = 0;
+            for (int j = 0; j < 31; j++) {
+                int shift = 2 * j;
+                unsigned block = ((window[0] >> shift) & 15) | (((window[1] >> shift) & 15) << 4) |
+                                 (((window[2] >> shift) & 15) << 8) | (((window[3] >> shift) & 15) << 12);
+                uint64_t result = table[block];
+                outTop |= (result & 3) << shift;
+                outBottom |= (result >> 2) << shift;
+            }
+
+            // El último par de columnas toma la columna 64k + 64 de la palabra siguiente
+            unsigned block = 0;
+            for (int r = 0; r < 4; r++) {
+                block |= (unsigned)(((rows[r][k] >> 61) | ((rows[r][k + 1] & 1) << 3)) & 15) << (r * 4);
+            }
+            uint64_t result = table[block];
+            outTop |= (result & 3) << 62;
+            outBottom |= (result >> 2) << 62;
+
+            if (k == lifeWordsPerRow - 1) {
+                // Los bits de relleno de la última palabra siempre quedan muertos
+                outTop &= lifeLastWordMask;
+                outBottom &= lifeLastWordMask;
+            }
+
+            // En un toro la fila actual lleva la primera columna en los bits de relleno
+            uint64_t mask = (k == lifeWordsPerRow - 1) ? lifeLastWordMask : ~0ULL;
+            top[k] = outTop;
+            spanDiff[k - k0] |= (outTop ^ current[k]);
+            lifeCountChanges(current[k] & mask, outTop, births, deaths);
+            if (pair) {
+                bottom[k] = outBottom;
+                spanDiff[k - k0] |= (outBottom ^ currentBelow[k]);
+                lifeCountChanges(currentBelow[k] & mask, outBottom, births, deaths);
+            }
+        }
+    }
+    addLifeChanges(births, deaths);
+
+    if (k1 == lifeWordsPerRow) {
+        // En un toro la fila actual lleva la primera columna en los bits de relleno
+        spanDiff[k1 - 1 - k0] &= lifeLastWordMask;
+    }
+    for (int k = k0; k < k1; k++) {
+        changed[k] = spanDiff[k - k0] != 0;
+    }
+}
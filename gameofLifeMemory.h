@@ -0,0 +1,298 @@
+// Memoria del tablero de bits en máquinas con varios nodos NUMA. Los buffers se
+// piden con mmap y nadie los toca hasta que cada banda de LIFE_TILE_ROWS filas la
+// escribe por primera vez un hilo del mismo reparto estático que usa el
+// planificador steal para empezar, así que Linux pone sus páginas en el nodo de
+// ese hilo (first touch). Con --huge-pages los buffers se alinean a 2 MB y se
+// piden páginas enormes transparentes; con --affinity los hilos de OpenMP se fijan
+// a CPUs para que no se alejen de su memoria. Se incluye desde gameofLife.h.
+
+// Cómo se fijan los hilos a las CPUs (--affinity)
+enum LifeAffinity {
+    LIFE_AFFINITY_NONE,     // Los decide el sistema (o OMP_PROC_BIND)
+    LIFE_AFFINITY_COMPACT,  // Hilos seguidos en CPUs seguidas, llenando un nodo antes del siguiente
+    LIFE_AFFINITY_SCATTER   // Hilos repartidos por turnos entre los nodos y separados dentro de cada uno
+};
+
+LifeAffinity lifeAffinity = LIFE_AFFINITY_NONE;
+bool lifeHugePages = false;
+
+// Los buffers del tablero se comparten con los procesos trabajadores (--processes)
+bool lifeSharedBuffers = false;
+
+// CPU de cada hilo de OpenMP tras fijarlos (vacío si no se fijaron)
+vector<int> lifeThreadCpus;
+
+const size_t LIFE_HUGE_PAGE = 2 << 20;
+
+// Bytes que ocupa en memoria un buffer de "words" palabras
+size_t lifeBufferBytes(size_t words) {
+    size_t page = lifeHugePages ? LIFE_HUGE_PAGE : (size_t)sysconf(_SC_PAGESIZE);
+    return (words * sizeof(uint64_t) + page - 1) / page * page;
+}
+
+// Mapea un objeto nuevo de memoria compartida POSIX. El nombre se borra enseguida:
+// el objeto vive mientras esté mapeado, y los procesos hijos lo heredan con fork.
+void* mapLifeShared(size_t bytes) {
+    static int created = 0;
+    char name[64];
+    snprintf(name, sizeof(name), "/gameoflife-%d-%d", (int)getpid(), created++);
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        return MAP_FAILED;
+    }
+    shm_unlink(name);
+    void* mapped = MAP_FAILED;
+    if (ftruncate(fd, bytes) == 0) {
+        mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    return mapped;
+}
+
+// Reserva un buffer de generación sin tocar sus páginas (ver clearLifeBuffer).
+// Vive fuera de la pila, así que el tamaño del tablero no depende de ella.
+uint64_t* allocateLifeBuffer(size_t words) {
+    size_t bytes = lifeBufferBytes(words);
+    size_t extra = lifeHugePages ? LIFE_HUGE_PAGE : 0;
+    void* mapped = lifeSharedBuffers ? mapLifeShared(bytes + extra)
+                                     : mmap(nullptr, bytes + extra, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED) {
+        cerr << "Failed to allocate Game of Life buffer (" << bytes << " bytes)" << endl;
+        exit(1);
+    }
+
+    char* buffer = static_cast<char*>(mapped);
+    if (lifeHugePages) {
+        // Se recorta lo que sobra a los lados para que el buffer empiece en una página de 2 MB
+        char* aligned = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(buffer) + LIFE_HUGE_PAGE - 1) & ~(uintptr_t)(LIFE_HUGE_PAGE - 1));
+        if (aligned > buffer) {
+            munmap(buffer, aligned - buffer);
+        }
+        if (aligned + bytes < buffer + bytes + extra) {
+            munmap(aligned + bytes, buffer + extra - aligned);
+        }
+        buffer = aligned;
+        madvise(buffer, bytes, MADV_HUGEPAGE);
+    }
+    return reinterpret_cast<uint64_t*>(buffer);
+}
+
+void freeLifeBuffer(uint64_t* buffer, size_t words) {
+    if (buffer) {
+        munmap(buffer, lifeBufferBytes(words));
+    }
+}
+
+// Deja muertas todas las células de un buffer de lifeWords palabras. Cada hilo
+// escribe un bloque contiguo de bandas (la primera lleva también la fila de halo
+// de arriba y la última la de abajo), así que en un buffer recién reservado es
+// el primero en tocar esas páginas.
+void clearLifeBuffer(uint64_t* buffer) {
+    const int bands = lifeTileRows;
+    #pragma omp parallel for schedule(static)
+    for (int ty = 0; ty < bands; ty++) {
+        size_t first = ty == 0 ? 0 : (size_t)(ty * LIFE_TILE_ROWS + 1) * lifeStride;
+        size_t last = ty == bands - 1 ? lifeWords : (size_t)((ty + 1) * LIFE_TILE_ROWS + 1) * lifeStride;
+        memset(buffer + first, 0, (last - first) * sizeof(uint64_t));
+    }
+}
+
+// Lee una lista de CPUs de Linux ("0-7,16-23"); devuelve false si no se puede abrir
+bool readLifeCpuList(const char* path, vector<int>& cpus) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return false;
+    }
+    int first, last;
+    char separator;
+    while (fscanf(file, "%d", &first) == 1) {
+        last = first;
+        if (fscanf(file, "%c", &separator) == 1 && separator == '-') {
+            if (fscanf(file, "%d", &last) != 1) {
+                break;
+            }
+            separator = fgetc(file);
+        }
+        for (int cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+        if (separator != ',') {
+            break;
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+// CPUs que el proceso puede usar, agrupadas por nodo NUMA (un solo grupo si el
+// sistema no expone los nodos)
+vector<vector<int>> lifeNumaNodes() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+
+    vector<vector<int>> nodes;
+    for (int node = 0;; node++) {
+        char path[64];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        vector<int> cpus;
+        if (!readLifeCpuList(path, cpus)) {
+            break;
+        }
+        cpus.erase(remove_if(cpus.begin(), cpus.end(), [&](int cpu) { return !CPU_ISSET(cpu, &allowed); }), cpus.end());
+        if (!cpus.empty()) {
+            nodes.push_back(cpus);
+        }
+    }
+
+    if (nodes.empty()) {
+        nodes.emplace_back();
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &allowed)) {
+                nodes.back().push_back(cpu);
+            }
+        }
+    }
+    return nodes;
+}
+
+// CPU para cada uno de "threads" hilos según lifeAffinity, con las CPUs agrupadas por nodo
+vector<int> lifeAffinityCpus(const vector<vector<int>>& nodes, int threads) {
+    vector<int> cpus(threads);
+    if (lifeAffinity == LIFE_AFFINITY_COMPACT) {
+        // Las CPUs en orden de nodo, una tras otra
+        vector<int> ordered;
+        for (const vector<int>& node : nodes) {
+            ordered.insert(ordered.end(), node.begin(), node.end());
+        }
+        for (int t = 0; t < threads; t++) {
+            cpus[t] = ordered[t % ordered.size()];
+        }
+        return cpus;
+    }
+
+    // Un hilo por nodo por turnos; dentro de cada nodo, sus hilos quedan lo más
+    // separados posible (en núcleos distintos si los hermanos de SMT van al final)
+    const int nodeCount = nodes.size();
+    for (int t = 0; t < threads; t++) {
+        const vector<int>& node = nodes[t % nodeCount];
+        int perNode = (threads - t % nodeCount + nodeCount - 1) / nodeCount;
+        int slot = t / nodeCount;
+        cpus[t] = node[(size_t)slot * node.size() / perNode];
+    }
+    return cpus;
+}
+
+// Fija el hilo que llama, dentro de una región paralela, a la CPU que le toca
+// por su número en el equipo (nada si no se eligió --affinity)
+void pinLifeThread() {
+#ifdef _OPENMP
+    size_t thread = omp_get_thread_num();
+    if (thread < lifeThreadCpus.size()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(lifeThreadCpus[thread], &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#endif
+}
+
+// Fija cada hilo de OpenMP a una CPU según lifeAffinity. Los hilos del equipo se
+// reutilizan en las regiones siguientes, así que basta con hacerlo una vez antes
+// de tocar el tablero. Un equipo abierto desde otro hilo (el de simulación) es
+// otro grupo de hilos: se fija con pinLifeThread al empezar.
+void applyLifeAffinity() {
+#ifdef _OPENMP
+    if (lifeAffinity == LIFE_AFFINITY_NONE) {
+        return;
+    }
+
+    const int threads = omp_get_max_threads();
+    lifeThreadCpus = lifeAffinityCpus(lifeNumaNodes(), threads);
+
+    #pragma omp parallel num_threads(threads)
+    pinLifeThread();
+#endif
+}
+
+// Nodo NUMA de hasta "samples" páginas repartidas por el buffer (move_pages sin
+// destino solo consulta); vacío si el kernel no lo informa
+vector<int> lifeBufferNodes(uint64_t* buffer, size_t words, size_t samples) {
+    const size_t page = sysconf(_SC_PAGESIZE);
+    const size_t pages = (words * sizeof(uint64_t) + page - 1) / page;
+    samples = min(samples, pages);
+
+    vector<void*> addresses(samples);
+    vector<int> status(samples, -1);
+    for (size_t i = 0; i < samples; i++) {
+        addresses[i] = reinterpret_cast<char*>(buffer) + (i * pages / samples) * page;
+    }
+    if (syscall(SYS_move_pages, 0, samples, addresses.data(), nullptr, status.data(), 0) != 0) {
+        return {};
+    }
+    return status;
+}
+
+// Modo de páginas enormes transparentes del kernel ("always", "madvise" o "never")
+string lifeTransparentHugePages() {
+    FILE* file = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+    if (!file) {
+        return "unavailable";
+    }
+    char line[128] = "";
+    fgets(line, sizeof(line), file);
+    fclose(file);
+    const char* open = strchr(line, '[');
+    const char* close = open ? strchr(open, ']') : nullptr;
+    return close ? string(open + 1, close) : "unknown";
+}
+
+// Informe de arranque: hilos y sus CPUs, nodos, páginas enormes y en qué nodo
+// quedaron las páginas del tablero
+void reportLifeMemory() {
+    vector<vector<int>> nodes = lifeNumaNodes();
+    const char* affinity[] = { "none", "compact", "scatter" };
+
+#ifdef _OPENMP
+    const int threads = omp_get_max_threads();
+#else
+    const int threads = 1;
+#endif
+    cout << "Threads: " << threads << " (affinity " << affinity[lifeAffinity];
+    if (!lifeThreadCpus.empty()) {
+        cout << ", cpus";
+        for (size_t t = 0; t < lifeThreadCpus.size(); t++) {
+            cout << (t ? "," : " ") << lifeThreadCpus[t];
+        }
+    }
+    cout << ") - NUMA nodes: " << nodes.size() << endl;
+
+    char size[64];
+    size_t bytes = lifeBufferBytes(lifeWords);
+    if (bytes < (1 << 20)) {
+        snprintf(size, sizeof(size), "%zu KB", bytes >> 10);
+    } else {
+        snprintf(size, sizeof(size), "%.1f MB", bytes / 1048576.0);
+    }
+    cout << "Bit grid: 2 x " << size << " - Huge pages: " << (lifeHugePages ? "on" : "off")
+         << " (THP " << lifeTransparentHugePages() << ")";
+
+    vector<int> pageNodes = lifeBufferNodes(lifeCells, lifeWords, 1024);
+    vector<int> more = lifeBufferNodes(lifeNextCells, lifeWords, 1024);
+    pageNodes.insert(pageNodes.end(), more.begin(), more.end());
+    vector<size_t> perNode;
+    for (int node : pageNodes) {
+        if (node >= 0) {
+            perNode.resize(max<size_t>(perNode.size(), node + 1));
+            perNode[node]++;
+        }
+    }
+    size_t placed = accumulate(perNode.begin(), perNode.end(), (size_t)0);
+    if (placed > 0) {
+        cout << " - Pages per node:";
+        for (size_t node = 0; node < perNode.size(); node++) {
+            cout << " " << node << ": " << perNode[node] * 100 / placed << "%";
+        }
+    }
+    cout << endl;
+}
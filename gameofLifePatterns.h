@@ -0,0 +1,331 @@
+// Carga de patrones desde archivos RLE, Life 1.06 y plaintext (.cells). El archivo
+// se mapea en memoria y se recorre una vez escribiendo las células directamente en
+// el tablero de bits (las tiradas de células vivas se escriben por palabras), sin
+// listas intermedias, así que cargar un patrón grande cuesta lo que leer el
+// archivo. Se incluye desde gameofLife.h.
+
+// Patrón a cargar al inicializar (--pattern) y su posición (--pattern-at)
+string lifePatternPath;
+bool lifePatternCentered = true;
+int64_t lifePatternX = 0;
+int64_t lifePatternY = 0;
+
+// Mayor coordenada o dimensión que se acepta en un archivo: lejos de desbordar
+// las cuentas con el origen, y mucho más que cualquier universo
+const int64_t LIFE_PATTERN_MAX_COORDINATE = 1LL << 40;
+
+enum LifePatternFormat {
+    LIFE_PATTERN_RLE,
+    LIFE_PATTERN_LIFE106,
+    LIFE_PATTERN_CELLS
+};
+
+// Pone vivas las células [x, x + count) de la fila y; lo que cae fuera del universo se descarta
+void setLifeRun(int64_t x, int64_t y, int64_t count) {
+    if (y < 0 || y >= universeHeight) {
+        return;
+    }
+    int64_t x0 = max<int64_t>(x, 0);
+    int64_t x1 = min<int64_t>(x + count, universeWidth);
+    if (x0 >= x1) {
+        return;
+    }
+
+    uint64_t* row = lifeRow(lifeCells, y);
+    int64_t k0 = x0 / LIFE_WORD_BITS;
+    int64_t k1 = (x1 - 1) / LIFE_WORD_BITS;
+    uint64_t first = ~0ULL << (x0 % LIFE_WORD_BITS);
+    uint64_t last = ~0ULL >> (LIFE_WORD_BITS - 1 - (x1 - 1) % LIFE_WORD_BITS);
+    if (k0 == k1) {
+        row[k0] |= first & last;
+        return;
+    }
+    row[k0] |= first;
+    for (int64_t k = k0 + 1; k < k1; k++) {
+        row[k] = ~0ULL;
+    }
+    row[k1] |= last;
+}
+
+// Salta hasta el comienzo de la línea siguiente
+inline const char* skipLifeLine(const char* p, const char* end) {
+    if (p >= end) {
+        return end;
+    }
+    const char* newline = static_cast<const char*>(memchr(p, '\n', end - p));
+    return newline ? newline + 1 : end;
+}
+
+inline const char* skipLifeSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+    return p;
+}
+
+// Lee un entero con signo opcional; devuelve false si no hay dígitos o si pasa
+// de LIFE_PATTERN_MAX_COORDINATE
+bool readLifeInteger(const char*& p, const char* end, int64_t& value) {
+    p = skipLifeSpaces(p, end);
+    bool negative = p < end && *p == '-';
+    if (p < end && (*p == '-' || *p == '+')) {
+        p++;
+    }
+    if (p >= end || *p < '0' || *p > '9') {
+        return false;
+    }
+    value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p++ - '0');
+        if (value > LIFE_PATTERN_MAX_COORDINATE) {
+            return false;
+        }
+    }
+    if (negative) {
+        value = -value;
+    }
+    return true;
+}
+
+// Reconoce el formato por el contenido: "#Life 1.06" al principio, una cabecera
+// "x = ..." después de los comentarios '#' del RLE, o si no, plaintext
+LifePatternFormat detectLifePatternFormat(const char* p, const char* end) {
+    const char* header = "#Life 1.06";
+    if ((size_t)(end - p) >= strlen(header) && memcmp(p, header, strlen(header)) == 0) {
+        return LIFE_PATTERN_LIFE106;
+    }
+    while (p < end) {
+        const char* line = skipLifeSpaces(p, end);
+        if (line < end && *line == '#') {
+            p = skipLifeLine(line, end);
+            continue;
+        }
+        if (line < end && *line == 'x') {
+            return LIFE_PATTERN_RLE;
+        }
+        break;
+    }
+    return LIFE_PATTERN_CELLS;
+}
+
+// RLE: comentarios '#', cabecera "x = <ancho>, y = <alto>[, rule = ...]" y el
+// cuerpo con tiradas "<n><tag>", donde b es muerta, o viva, $ fin de fila y ! fin
+bool loadLifeRle(const char* p, const char* end, bool centered, int64_t x, int64_t y) {
+    while (p < end && *skipLifeSpaces(p, end) == '#') {
+        p = skipLifeLine(skipLifeSpaces(p, end), end);
+    }
+
+    int64_t width = 0, height = 0;
+    const char* header = p;
+    p = skipLifeLine(p, end);
+    for (const char* q = header; q < p; q++) {
+        if ((*q == 'x' || *q == 'y') && (q == header || q[-1] == ' ' || q[-1] == ',')) {
+            const char* value = skipLifeSpaces(q + 1, p);
+            if (value < p && *value == '=') {
+                value++;
+                if (!readLifeInteger(value, p, *q == 'x' ? width : height)) {
+                    return false;
+                }
+                q = value - 1;
+            }
+        }
+    }
+    if (width < 0 || height < 0) {
+        return false;
+    }
+
+    int64_t originX = centered ? (universeWidth - width) / 2 : x;
+    int64_t originY = centered ? (universeHeight - height) / 2 : y;
+    int64_t cellX = 0, cellY = 0;
+
+    // Una tirada no puede ser más larga que el patrón o el universo
+    const int64_t maxRun = max<int64_t>({ width, height, universeWidth, universeHeight });
+
+    while (p < end) {
+        int64_t run = 1;
+        if (*p >= '0' && *p <= '9') {
+            run = 0;
+            while (p < end && *p >= '0' && *p <= '9') {
+                run = run * 10 + (*p++ - '0');
+                if (run > maxRun) {
+                    return false;
+                }
+            }
+            if (p == end) {
+                return false;
+            }
+        }
+
+        char tag = *p++;
+        switch (tag) {
+            case 'o':
+            case 'A':
+                setLifeRun(originX + cellX, originY + cellY, run);
+                cellX += run;
+                break;
+            case 'b':
+            case '.':
+                cellX += run;
+                break;
+            case '$':
+                cellY += run;
+                cellX = 0;
+                break;
+            case '!':
+                return true;
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+                break;
+            default:
+                if (tag >= 'p' && tag <= 'y' && p < end) {
+                    // Estado de dos caracteres de las reglas Generations: no es una célula viva
+                    p++;
+                    cellX += run;
+                } else if (tag >= 'B' && tag <= 'X') {
+                    cellX += run;
+                } else {
+                    return false;
+                }
+        }
+
+        // Como las tiradas, la posición no pasa de la mayor coordenada: sumar
+        // tiradas sin ese tope terminaría desbordando
+        if (cellX > LIFE_PATTERN_MAX_COORDINATE || cellY > LIFE_PATTERN_MAX_COORDINATE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Life 1.06: una célula viva "x y" por línea, con coordenadas relativas al origen
+bool loadLifeLife106(const char* begin, const char* end, bool centered, int64_t x, int64_t y) {
+    // Centrar necesita la caja del patrón, así que se recorre una vez más
+    int64_t minX = 0, minY = 0, maxX = -1, maxY = -1;
+    for (int pass = centered ? 0 : 1; pass < 2; pass++) {
+        int64_t originX = x, originY = y;
+        if (pass == 1 && centered) {
+            originX = (universeWidth - (maxX - minX + 1)) / 2 - minX;
+            originY = (universeHeight - (maxY - minY + 1)) / 2 - minY;
+        }
+
+        bool first = true;
+        const char* p = begin;
+        while (p < end) {
+            const char* line = skipLifeSpaces(p, end);
+            p = skipLifeLine(line, end);
+            if (line == end || *line == '#' || *line == '\n') {
+                continue;
+            }
+
+            int64_t cellX, cellY;
+            if (!readLifeInteger(line, p, cellX) || !readLifeInteger(line, p, cellY)) {
+                return false;
+            }
+            if (pass == 1) {
+                setLifeRun(originX + cellX, originY + cellY, 1);
+            } else if (first) {
+                minX = maxX = cellX;
+                minY = maxY = cellY;
+                first = false;
+            } else {
+                minX = min(minX, cellX);
+                maxX = max(maxX, cellX);
+                minY = min(minY, cellY);
+                maxY = max(maxY, cellY);
+            }
+        }
+    }
+    return true;
+}
+
+// Plaintext (.cells): comentarios '!', una fila por línea con 'O' (o '*') viva y '.' muerta
+bool loadLifeCells(const char* begin, const char* end, bool centered, int64_t x, int64_t y) {
+    int64_t originX = x, originY = y;
+    if (centered) {
+        int64_t width = 0, height = 0;
+        for (const char* p = begin; p < end;) {
+            const char* line = p;
+            p = skipLifeLine(line, end);
+            if (*line == '!') {
+                continue;
+            }
+            const char* lineEnd = p;
+            while (lineEnd > line && (lineEnd[-1] == '\n' || lineEnd[-1] == '\r')) {
+                lineEnd--;
+            }
+            width = max<int64_t>(width, lineEnd - line);
+            height++;
+        }
+        originX = (universeWidth - width) / 2;
+        originY = (universeHeight - height) / 2;
+    }
+
+    int64_t cellY = 0;
+    for (const char* p = begin; p < end;) {
+        const char* line = p;
+        p = skipLifeLine(line, end);
+        if (*line == '!') {
+            continue;
+        }
+        for (const char* q = line; q < p; q++) {
+            if (*q != 'O' && *q != '*') {
+                continue;
+            }
+            const char* runEnd = q;
+            while (runEnd < p && (*runEnd == 'O' || *runEnd == '*')) {
+                runEnd++;
+            }
+            setLifeRun(originX + (q - line), originY + cellY, runEnd - q);
+            q = runEnd - 1;
+        }
+        cellY++;
+    }
+    return true;
+}
+
+// Carga el archivo en el tablero de bits, con la esquina superior izquierda del
+// patrón en (x, y) (en Life 1.06, el origen de sus coordenadas) o centrado en el
+// universo. Las células que caen fuera del universo se descartan.
+bool loadLifePattern(const string& path, bool centered, int64_t x, int64_t y) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        cerr << "Cannot open pattern file '" << path << "'" << endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        cerr << "Cannot read pattern file '" << path << "'" << endl;
+        return false;
+    }
+
+    size_t size = info.st_size;
+    bool loaded = true;
+    if (size > 0) {
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            close(fd);
+            cerr << "Cannot map pattern file '" << path << "'" << endl;
+            return false;
+        }
+        madvise(mapped, size, MADV_SEQUENTIAL);
+
+        const char* begin = static_cast<const char*>(mapped);
+        const char* end = begin + size;
+        switch (detectLifePatternFormat(begin, end)) {
+            case LIFE_PATTERN_RLE: loaded = loadLifeRle(begin, end, centered, x, y); break;
+            case LIFE_PATTERN_LIFE106: loaded = loadLifeLife106(skipLifeLine(begin, end), end, centered, x, y); break;
+            case LIFE_PATTERN_CELLS: loaded = loadLifeCells(begin, end, centered, x, y); break;
+        }
+        munmap(mapped, size);
+    }
+    close(fd);
+    markAllLifeTilesChanged();
+
+    if (!loaded) {
+        cerr << "Invalid pattern file '" << path << "'" << endl;
+    }
+    return loaded;
+}
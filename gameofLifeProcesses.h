@@ -0,0 +1,339 @@
+// Simulación repartida entre procesos (--processes n). El universo se divide en
+// bandas horizontales de filas de teselas y cada banda la calcula un proceso
+// trabajador creado con fork. Los dos buffers del tablero viven en memoria
+// compartida POSIX (ver mapLifeShared), así que las filas de halo que un
+// trabajador necesita de sus vecinos son las últimas filas que ellos escribieron,
+// sin copias, y el proceso principal pinta directamente desde esos buffers.
+//
+// Cada trabajador publica cuántas generaciones terminó en un contador compartido
+// y, antes de calcular la siguiente, espera (con un futex) a que sus dos vecinos
+// hayan terminado la anterior: solo así ya escribieron las filas y las teselas
+// cambiadas que va a leer, y ya no leen el buffer que va a sobrescribir. El
+// proceso principal pide generaciones subiendo un contador de órdenes y espera a
+// que todos terminen. Un trabajador que muere no corrompe la memoria del
+// principal: se detecta y el programa termina con un error. Cada trabajador
+// calcula en un solo hilo (OpenMP no se puede usar después de fork).
+// Se incluye desde gameofLife.h.
+
+// Cantidad de procesos trabajadores (--processes); 0 calcula en el mismo proceso
+int lifeProcesses = 0;
+
+// Contadores de un trabajador, cada uno en su línea de caché
+struct alignas(LIFE_CACHE_LINE) LifeWorkerSlot {
+    atomic<uint32_t> done;  // Generaciones terminadas desde que arrancó
+    uint64_t births;        // Estadísticas de la última orden
+    uint64_t deaths;
+    uint64_t activeTiles;
+};
+
+// Bloque de control compartido; después van los contadores de cada trabajador y
+// las teselas cambiadas (dos generaciones y la unión de la orden)
+struct alignas(LIFE_CACHE_LINE) LifeProcessControl {
+    atomic<uint32_t> target;    // Generaciones pedidas desde que arrancaron
+    atomic<uint32_t> finished;  // Trabajadores que terminaron la orden actual
+    atomic<uint32_t> stop;
+    int current;                // Buffer (0 o 1) con la generación de partida
+};
+
+LifeProcessControl* lifeProcessControl = nullptr;
+size_t lifeProcessControlBytes = 0;
+LifeWorkerSlot* lifeWorkerSlots = nullptr;
+uint8_t* lifeProcessChanged[2] = { nullptr, nullptr };
+uint8_t* lifeProcessDirty = nullptr;
+vector<pid_t> lifeWorkerPids;
+
+// Buffers y geometría con que se crearon los trabajadores (heredados con fork)
+uint64_t* lifeProcessBuffers[2] = { nullptr, nullptr };
+size_t lifeProcessWords = 0;
+LifeBoundary lifeProcessBoundary = LIFE_BOUNDARY_DEAD;
+
+inline void lifeFutexWait(atomic<uint32_t>& word, uint32_t value, const timespec* timeout = nullptr) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, value, timeout, nullptr, 0);
+}
+
+inline void lifeFutexWake(atomic<uint32_t>& word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+// Espera a que counter llegue a value. Los vecinos suelen terminar casi a la vez,
+// así que primero se insiste un poco antes de dormir en el futex.
+void waitLifeCounter(atomic<uint32_t>& counter, uint32_t value) {
+    for (int spin = 0; spin < 4096; spin++) {
+        if ((int32_t)(counter.load(memory_order_acquire) - value) >= 0) {
+            return;
+        }
+        __builtin_ia32_pause();
+    }
+    while (true) {
+        uint32_t seen = counter.load(memory_order_acquire);
+        if ((int32_t)(seen - value) >= 0) {
+            return;
+        }
+        lifeFutexWait(counter, seen);
+    }
+}
+
+// Avanza una generación de las filas de teselas [ty0, ty1) del trabajador, de
+// lifeCells a lifeNextCells, con las teselas cambiadas de lifeProcessChanged[cur]
+void stepLifeWorkerBands(int ty0, int ty1, int cur, LifeSpanUpdate updateSpan, uint64_t& activeTiles) {
+    const int cols = lifeTileCols;
+    const int rows = lifeTileRows;
+    const bool wrap = lifeBoundary == LIFE_BOUNDARY_WRAP;
+    const uint8_t* changed = lifeProcessChanged[cur];
+    uint8_t* nextChanged = lifeProcessChanged[cur ^ 1];
+
+    // Teselas activas: las que cambiaron y sus vecinas, incluidas las filas de
+    // teselas de los trabajadores de arriba y de abajo
+    for (int ty = ty0; ty < ty1; ty++) {
+        uint8_t* active = &lifeTileActive[(size_t)ty * cols];
+        fill(active, active + cols, 0);
+        for (int dy = -1; dy <= 1; dy++) {
+            int ny = ty + dy;
+            if (wrap) {
+                ny = (ny + rows) % rows;
+            } else if (ny < 0 || ny >= rows) {
+                continue;
+            }
+            const uint8_t* source = &changed[(size_t)ny * cols];
+            for (int tx = 0; tx < cols; tx++) {
+                if (!source[tx]) {
+                    continue;
+                }
+                active[tx] = 1;
+                if (tx > 0 || wrap) {
+                    active[(tx + cols - 1) % cols] = 1;
+                }
+                if (tx < cols - 1 || wrap) {
+                    active[(tx + 1) % cols] = 1;
+                }
+            }
+        }
+        activeTiles += count(active, active + cols, 1);
+    }
+
+    for (int ty = ty0; ty < ty1; ty++) {
+        updateGameOfLifeBand(ty, updateSpan);
+    }
+
+    // Las palabras de halo de las filas nuevas quedan listas para quien las lea
+    int y0 = ty0 * LIFE_TILE_ROWS;
+    int y1 = min(ty1 * LIFE_TILE_ROWS, universeHeight);
+    for (int y = y0; y < y1; y++) {
+        fillLifeRowHalo(lifeRow(lifeNextCells, y));
+    }
+    if (wrap && y0 == 0) {
+        memcpy(lifeRow(lifeNextCells, universeHeight) - LIFE_ROW_OFFSET, lifeRow(lifeNextCells, 0) - LIFE_ROW_OFFSET,
+               lifeStride * sizeof(uint64_t));
+    }
+    if (wrap && y1 == universeHeight) {
+        memcpy(lifeRow(lifeNextCells, -1) - LIFE_ROW_OFFSET, lifeRow(lifeNextCells, universeHeight - 1) - LIFE_ROW_OFFSET,
+               lifeStride * sizeof(uint64_t));
+    }
+
+    const size_t first = (size_t)ty0 * cols, last = (size_t)ty1 * cols;
+    memcpy(nextChanged + first, &lifeNextTileChanged[first], last - first);
+    for (size_t tile = first; tile < last; tile++) {
+        lifeProcessDirty[tile] |= nextChanged[tile];
+    }
+}
+
+// Ciclo de un proceso trabajador: espera órdenes y calcula sus bandas
+[[noreturn]] void runLifeWorker(int worker, int workers, LifeSpanUpdate updateSpan) {
+    const int ty0 = worker * lifeTileRows / workers;
+    const int ty1 = (worker + 1) * lifeTileRows / workers;
+    const bool wrap = lifeBoundary == LIFE_BOUNDARY_WRAP;
+    // Vecinos de los que se leen filas; sin toro, los extremos tienen uno solo
+    const int above = worker > 0 ? worker - 1 : (wrap ? workers - 1 : -1);
+    const int below = worker < workers - 1 ? worker + 1 : (wrap ? 0 : -1);
+
+    LifeWorkerSlot& slot = lifeWorkerSlots[worker];
+    LifeProcessControl& control = *lifeProcessControl;
+    uint32_t done = slot.done.load(memory_order_relaxed);
+
+    while (true) {
+        uint32_t target;
+        while ((target = control.target.load(memory_order_acquire)) == done && !control.stop.load(memory_order_acquire)) {
+            lifeFutexWait(control.target, done);
+        }
+        if (control.stop.load(memory_order_acquire)) {
+            _exit(0);
+        }
+
+        int cur = control.current;
+        uint64_t activeTiles = 0;
+        lifeBirths = 0;
+        lifeDeaths = 0;
+        memset(lifeProcessDirty + (size_t)ty0 * lifeTileCols, 0, (size_t)(ty1 - ty0) * lifeTileCols);
+
+        for (; done != target; done++) {
+            if (above >= 0 && above != worker) {
+                waitLifeCounter(lifeWorkerSlots[above].done, done);
+            }
+            if (below >= 0 && below != worker) {
+                waitLifeCounter(lifeWorkerSlots[below].done, done);
+            }
+
+            lifeCells = lifeProcessBuffers[cur];
+            lifeNextCells = lifeProcessBuffers[cur ^ 1];
+            stepLifeWorkerBands(ty0, ty1, cur, updateSpan, activeTiles);
+            cur ^= 1;
+
+            slot.done.store(done + 1, memory_order_release);
+            lifeFutexWake(slot.done);
+        }
+
+        slot.births = lifeBirths;
+        slot.deaths = lifeDeaths;
+        slot.activeTiles = activeTiles;
+        if (control.finished.fetch_add(1, memory_order_acq_rel) + 1 == (uint32_t)workers) {
+            lifeFutexWake(control.finished);
+        }
+    }
+}
+
+// Detiene los trabajadores y libera el bloque de control
+void stopLifeWorkers() {
+    if (lifeWorkerPids.empty()) {
+        return;
+    }
+    lifeProcessControl->stop.store(1, memory_order_release);
+    lifeFutexWake(lifeProcessControl->target);
+    for (pid_t pid : lifeWorkerPids) {
+        waitpid(pid, nullptr, 0);
+    }
+    lifeWorkerPids.clear();
+    munmap(lifeProcessControl, lifeProcessControlBytes);
+    lifeProcessControl = nullptr;
+}
+
+// Crea los trabajadores para el tablero actual; false si no se pudo
+bool startLifeWorkers(LifeSpanUpdate updateSpan) {
+    const int workers = min(lifeProcesses, lifeTileRows);
+    const size_t tiles = (size_t)lifeTileCols * lifeTileRows;
+
+    size_t slotsOffset = sizeof(LifeProcessControl);
+    size_t changedOffset = slotsOffset + workers * sizeof(LifeWorkerSlot);
+    lifeProcessControlBytes = changedOffset + 3 * tiles;
+    void* mapped = mapLifeShared(lifeProcessControlBytes);
+    if (mapped == MAP_FAILED) {
+        cerr << "Cannot create shared memory for worker processes" << endl;
+        return false;
+    }
+
+    char* base = static_cast<char*>(mapped);
+    lifeProcessControl = new (base) LifeProcessControl();
+    lifeWorkerSlots = reinterpret_cast<LifeWorkerSlot*>(base + slotsOffset);
+    for (int worker = 0; worker < workers; worker++) {
+        new (&lifeWorkerSlots[worker]) LifeWorkerSlot();
+    }
+    lifeProcessChanged[0] = reinterpret_cast<uint8_t*>(base + changedOffset);
+    lifeProcessChanged[1] = lifeProcessChanged[0] + tiles;
+    lifeProcessDirty = lifeProcessChanged[1] + tiles;
+
+    lifeProcessBuffers[0] = lifeCells;
+    lifeProcessBuffers[1] = lifeNextCells;
+    lifeProcessWords = lifeWords;
+    lifeProcessBoundary = lifeBoundary;
+
+    // Salida estándar vacía para que los hijos no repitan lo que quedó en el búfer
+    cout.flush();
+    fflush(nullptr);
+    const pid_t parent = getpid();
+    for (int worker = 0; worker < workers; worker++) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            cerr << "Cannot start worker process " << worker << endl;
+            stopLifeWorkers();
+            return false;
+        }
+        if (pid == 0) {
+            // Si el proceso principal muere, los trabajadores no quedan esperando
+            prctl(PR_SET_PDEATHSIG, SIGKILL);
+            if (getppid() != parent) {
+                _exit(1);
+            }
+            runLifeWorker(worker, workers, updateSpan);
+        }
+        lifeWorkerPids.push_back(pid);
+    }
+
+    static bool registered = false;
+    if (!registered) {
+        atexit(stopLifeWorkers);
+        registered = true;
+    }
+    return true;
+}
+
+// Termina el programa si algún trabajador murió
+void checkLifeWorkers() {
+    for (size_t worker = 0; worker < lifeWorkerPids.size(); worker++) {
+        int status;
+        if (waitpid(lifeWorkerPids[worker], &status, WNOHANG) == lifeWorkerPids[worker]) {
+            cerr << "Worker process " << worker << " exited unexpectedly ("
+                 << (WIFSIGNALED(status) ? strsignal(WTERMSIG(status)) : "exit") << ")" << endl;
+            lifeWorkerPids.erase(lifeWorkerPids.begin() + worker);
+            for (pid_t pid : lifeWorkerPids) {
+                kill(pid, SIGKILL);
+                waitpid(pid, nullptr, 0);
+            }
+            lifeWorkerPids.clear();
+            exit(1);
+        }
+    }
+}
+
+// Avanza lifeTemporalBlock generaciones con los procesos trabajadores
+void updateGameOfLifeProcesses() {
+    bool useTable = lifeEngine == LIFE_ENGINE_LUT || !lifeRowKernel;
+    if (useTable && lifeBlockTable.empty()) {
+        buildLifeBlockTable();
+    }
+
+    // Un cambio de tamaño o de borde necesita trabajadores nuevos
+    bool sameGrid = (lifeCells == lifeProcessBuffers[0] || lifeCells == lifeProcessBuffers[1]) &&
+                    lifeWords == lifeProcessWords && lifeBoundary == lifeProcessBoundary;
+    if (!lifeWorkerPids.empty() && !sameGrid) {
+        stopLifeWorkers();
+    }
+    if (lifeWorkerPids.empty() && (!lifeSharedBuffers || !startLifeWorkers(useTable ? updateGameOfLifeLutSpan : updateGameOfLifeSpan))) {
+        // Sin buffers compartidos o sin trabajadores se calcula en este proceso
+        cerr << "Warning: worker processes are not available; simulating in-process" << endl;
+        lifeProcesses = 0;
+        updateGameOfLifeBits();
+        return;
+    }
+
+    LifeProcessControl& control = *lifeProcessControl;
+    const int workers = lifeWorkerPids.size();
+    const size_t tiles = (size_t)lifeTileCols * lifeTileRows;
+
+    // El principal pudo escribir el tablero desde la última orden
+    fillLifeHalo();
+    int cur = lifeCells == lifeProcessBuffers[0] ? 0 : 1;
+    memcpy(lifeProcessChanged[cur], lifeTileChanged.data(), tiles);
+    control.current = cur;
+    control.finished.store(0, memory_order_relaxed);
+    control.target.fetch_add(lifeTemporalBlock, memory_order_acq_rel);
+    lifeFutexWake(control.target);
+
+    const timespec timeout = { 0, 100 * 1000 * 1000 };
+    uint32_t finished;
+    while ((finished = control.finished.load(memory_order_acquire)) != (uint32_t)workers) {
+        lifeFutexWait(control.finished, finished, &timeout);
+        checkLifeWorkers();
+    }
+
+    lifeActiveTiles = 0;
+    for (int worker = 0; worker < workers; worker++) {
+        lifeBirths += lifeWorkerSlots[worker].births;
+        lifeDeaths += lifeWorkerSlots[worker].deaths;
+        lifeActiveTiles += lifeWorkerSlots[worker].activeTiles;
+    }
+    if (lifeTemporalBlock % 2) {
+        swap(lifeCells, lifeNextCells);
+    }
+    // Se repintan las teselas que cambiaron en cualquier generación de la orden
+    memcpy(lifeTileChanged.data(), lifeProcessDirty, tiles);
+    colorizeChangedTiles();
+}
@@ -0,0 +1,185 @@
+// Reglas "Life-like" dadas como rulestring (B3/S23, B36/S23, ...).
+// Las reglas conocidas tienen kernels instanciados en compilación, donde la
+// regla queda reducida a lógica de bits sin saltos; cualquier otra regla usa la
+// tabla de bloques de gameofLifeLut.h. Se incluye desde gameofLife.h.
+
+// Máscara de cantidades de vecinos a partir de sus dígitos ("36" -> bits 3 y 6)
+constexpr int lifeDigitsMask(const char* digits) {
+    return *digits ? (1 << (*digits - '0')) | lifeDigitsMask(digits + 1) : 0;
+}
+
+struct LifeKnownRule {
+    const char* name;
+    int birth;
+    int survive;
+    LifeRowKernel (*kernel)();
+};
+
+#define LIFE_KNOWN_RULE(name, birth, survive) \
+    { name, lifeDigitsMask(birth), lifeDigitsMask(survive), selectLifeRowKernel<lifeDigitsMask(birth), lifeDigitsMask(survive)> }
+
+const LifeKnownRule lifeKnownRules[] = {
+    LIFE_KNOWN_RULE("life", "3", "23"),
+    LIFE_KNOWN_RULE("highlife", "36", "23"),
+    LIFE_KNOWN_RULE("seeds", "2", ""),
+    LIFE_KNOWN_RULE("daynight", "3678", "34678"),
+    LIFE_KNOWN_RULE("lifewithoutdeath", "3", "012345678"),
+    LIFE_KNOWN_RULE("replicator", "1357", "1357"),
+    LIFE_KNOWN_RULE("2x2", "36", "125"),
+    LIFE_KNOWN_RULE("diamoeba", "35678", "5678"),
+    LIFE_KNOWN_RULE("morley", "368", "245"),
+    LIFE_KNOWN_RULE("maze", "3", "12345"),
+    LIFE_KNOWN_RULE("anneal", "4678", "35678")
+};
+
+#undef LIFE_KNOWN_RULE
+
+int lifeRuleBirth = LIFE_CONWAY_BIRTH;
+int lifeRuleSurvive = LIFE_CONWAY_SURVIVE;
+// La regla activa tal como se escribió (--rule), incluidas las de varios estados
+// que no caben en las máscaras; es la que se guarda en los checkpoints
+string lifeRuleSpec = "B3/S23";
+
+// Rulestring en la forma B<dígitos>/S<dígitos>
+string formatLifeRule(int birth, int survive) {
+    string text = "B";
+    for (int n = 0; n <= 8; n++) {
+        if ((birth >> n) & 1) {
+            text += char('0' + n);
+        }
+    }
+    text += "/S";
+    for (int n = 0; n <= 8; n++) {
+        if ((survive >> n) & 1) {
+            text += char('0' + n);
+        }
+    }
+    return text;
+}
+
+// Lee una regla: un nombre conocido ("highlife"), "B36/S23" (también "S23/B36")
+// o la notación clásica "23/36" (supervivencia/nacimiento)
+bool parseLifeRule(const string& text, int& birth, int& survive) {
+    string rule;
+    for (char ch : text) {
+        rule += (char)tolower((unsigned char)ch);
+    }
+
+    for (const LifeKnownRule& known : lifeKnownRules) {
+        if (rule == known.name) {
+            birth = known.birth;
+            survive = known.survive;
+            return true;
+        }
+    }
+
+    size_t slash = rule.find('/');
+    if (slash == string::npos) {
+        return false;
+    }
+    string first = rule.substr(0, slash);
+    string second = rule.substr(slash + 1);
+
+    string birthDigits, surviveDigits;
+    if (!first.empty() && first[0] == 'b' && !second.empty() && second[0] == 's') {
+        birthDigits = first.substr(1);
+        surviveDigits = second.substr(1);
+    } else if (!first.empty() && first[0] == 's' && !second.empty() && second[0] == 'b') {
+        surviveDigits = first.substr(1);
+        birthDigits = second.substr(1);
+    } else {
+        surviveDigits = first;
+        birthDigits = second;
+    }
+
+    birth = 0;
+    survive = 0;
+    for (char digit : birthDigits) {
+        if (digit < '0' || digit > '8') {
+            return false;
+        }
+        birth |= 1 << (digit - '0');
+    }
+    for (char digit : surviveDigits) {
+        if (digit < '0' || digit > '8') {
+            return false;
+        }
+        survive |= 1 << (digit - '0');
+    }
+    return true;
+}
+
+// Activa una regla B/S en todos los motores. Si no hay kernel instanciado para
+// ella, lifeRowKernel queda en nullptr y el tablero de bits usa la tabla de bloques.
+void setLifeRule(int birth, int survive) {
+    lifeRuleBirth = birth;
+    lifeRuleSurvive = survive;
+
+    setLifeTransition(lifeRuleTransition(birth, survive));
+    lifeRuleTotalistic = true;
+
+    for (const LifeKnownRule& known : lifeKnownRules) {
+        if (known.birth == birth && known.survive == survive) {
+            lifeRowKernel = known.kernel();
+            break;
+        }
+    }
+}
+
+// Regla MAP de Golly: "MAP" y los 512 bits de la transición en base64 (86
+// dígitos, con o sin el relleno "=="). El bit i es el vecindario con NW N NE W C
+// E SW S SE de mayor a menor peso, el orden inverso al índice de lifeTransition.
+// Así se pueden dar reglas no totalísticas, como las isotrópicas de Hensel.
+bool parseLifeMapRule(const string& text, vector<uint8_t>& transition) {
+    static const char digitsAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const size_t digitCount = (LIFE_TRANSITION_SIZE + 5) / 6;
+
+    string prefix = text.substr(0, 3);
+    for (char& ch : prefix) {
+        ch = (char)tolower((unsigned char)ch);
+    }
+    if (prefix != "map") {
+        return false;
+    }
+    string digits = text.substr(3);
+    if (digits.size() == digitCount + 2 && digits.compare(digitCount, 2, "==") == 0) {
+        digits.resize(digitCount);
+    }
+    if (digits.size() != digitCount) {
+        return false;
+    }
+
+    vector<uint8_t> decoded(LIFE_TRANSITION_SIZE);
+    for (int d = 0; d < (int)digitCount; d++) {
+        const char* found = strchr(digitsAlphabet, digits[d]);
+        if (!found || !*found) {
+            return false;
+        }
+        int value = found - digitsAlphabet;
+        // Los 4 bits que sobran del último dígito se ignoran
+        for (int b = 0; b < 6 && d * 6 + b < LIFE_TRANSITION_SIZE; b++) {
+            int golly = d * 6 + b;
+            int index = 0;
+            for (int bit = 0; bit < 9; bit++) {
+                index |= ((golly >> bit) & 1) << (8 - bit);
+            }
+            decoded[index] = (value >> (5 - b)) & 1;
+        }
+    }
+    transition.swap(decoded);
+    return true;
+}
+
+// Máscaras B/S de una transición que solo depende de la cantidad de vecinos;
+// false si depende de cuáles son
+bool lifeTransitionMasks(const vector<uint8_t>& transition, int& birth, int& survive) {
+    birth = 0;
+    survive = 0;
+    for (int i = 0; i < LIFE_TRANSITION_SIZE; i++) {
+        if (transition[i]) {
+            int alive = (i >> 4) & 1;
+            (alive ? survive : birth) |= 1 << (__builtin_popcount(i) - alive);
+        }
+    }
+    return lifeRuleTransition(birth, survive) == transition;
+}
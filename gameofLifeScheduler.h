@@ -0,0 +1,127 @@
+// Planificador de teselas con robo de trabajo (--scheduler steal). Las teselas
+// activas se agrupan en tramos de hasta LIFE_STEAL_SPAN_TILES teselas seguidas de
+// una banda, y la lista de tramos, en orden de filas, se reparte en partes
+// contiguas: cada hilo empieza con una región del universo. Un hilo toma los
+// tramos de su parte por delante y, cuando se queda sin ninguno, roba la mitad
+// de atrás de la parte de otro, empezando por el hilo vecino. Cada parte es un
+// rango [inicio, fin) en una sola palabra atómica, así que tomar y robar son un
+// compare-and-swap, sin candados. Cada parte la recorre un trabajador de
+// lifeParallelFor; sin -fopenmp queda un solo hilo que recorre todo en orden.
+// Se incluye desde gameofLife.h.
+
+enum LifeScheduler {
+    LIFE_SCHEDULER_OMP,   // Bandas repartidas por OpenMP con schedule(dynamic)
+    LIFE_SCHEDULER_STEAL  // Tramos de teselas con colas por hilo y robo de trabajo
+};
+
+LifeScheduler lifeScheduler = LIFE_SCHEDULER_OMP;
+
+// Teselas por tramo: con menos, el costo de cada llamada al kernel por fila
+// se nota (con 8 el paso tarda un 50% más); con más, una banda muy activa
+// queda en pocos tramos que no se pueden repartir
+const int LIFE_STEAL_SPAN_TILES = 32;
+
+struct LifeWorkSpan {
+    int ty;
+    int k0;
+    int k1;
+};
+
+// Parte de la lista de un hilo, como (fin << 32) | inicio; cada una en su línea de caché
+struct alignas(LIFE_CACHE_LINE) LifeWorkQueue {
+    atomic<uint64_t> range;
+};
+
+vector<LifeWorkSpan> lifeWorkSpans;
+unique_ptr<LifeWorkQueue[]> lifeWorkQueues;
+int lifeWorkQueueCount = 0;
+
+inline uint64_t lifeWorkRange(uint32_t begin, uint32_t end) {
+    return ((uint64_t)end << 32) | begin;
+}
+
+// Toma el primer tramo de la parte propia; -1 si está vacía
+inline int takeLifeWork(LifeWorkQueue& queue) {
+    uint64_t range = queue.range.load(memory_order_relaxed);
+    while (true) {
+        uint32_t begin = (uint32_t)range, end = range >> 32;
+        if (begin >= end) {
+            return -1;
+        }
+        if (queue.range.compare_exchange_weak(range, lifeWorkRange(begin + 1, end), memory_order_acq_rel)) {
+            return begin;
+        }
+    }
+}
+
+// Roba la mitad de atrás de la parte de victim: devuelve su primer tramo y deja
+// el resto como parte propia del ladrón; -1 si no había nada
+inline int stealLifeWork(LifeWorkQueue& victim, LifeWorkQueue& own) {
+    uint64_t range = victim.range.load(memory_order_relaxed);
+    while (true) {
+        uint32_t begin = (uint32_t)range, end = range >> 32;
+        if (begin >= end) {
+            return -1;
+        }
+        uint32_t middle = begin + (end - begin) / 2;
+        if (victim.range.compare_exchange_weak(range, lifeWorkRange(begin, middle), memory_order_acq_rel)) {
+            // Los otros ladrones ven vacía la parte propia hasta este punto
+            own.range.store(lifeWorkRange(middle + 1, end), memory_order_release);
+            return middle;
+        }
+    }
+}
+
+// Avanza el tablero de bits con el planificador de robo de trabajo: una
+// generación, o lifeTemporalBlock si updateSpan es la del bloqueo temporal
+void updateGameOfLifeStealing(LifeSpanUpdate updateSpan) {
+    // Tramos de teselas activas, en orden de bandas y columnas
+    lifeWorkSpans.clear();
+    for (int ty = 0; ty < lifeTileRows; ty++) {
+        const uint8_t* active = &lifeTileActive[(size_t)ty * lifeTileCols];
+        memset(&lifeNextTileChanged[(size_t)ty * lifeTileCols], 0, lifeTileCols);
+        int k0 = 0;
+        while (k0 < lifeTileCols) {
+            if (!active[k0]) {
+                k0++;
+                continue;
+            }
+            int k1 = k0;
+            while (k1 < lifeTileCols && active[k1] && k1 - k0 < LIFE_STEAL_SPAN_TILES) {
+                k1++;
+            }
+            lifeWorkSpans.push_back({ ty, k0, k1 });
+            k0 = k1;
+        }
+    }
+
+    const int threads = lifeTeamThreads();
+    if (lifeWorkQueueCount != threads) {
+        lifeWorkQueues.reset(new LifeWorkQueue[threads]);
+        lifeWorkQueueCount = threads;
+    }
+    const size_t spans = lifeWorkSpans.size();
+    for (int t = 0; t < threads; t++) {
+        lifeWorkQueues[t].range.store(lifeWorkRange(spans * t / threads, spans * (t + 1) / threads), memory_order_relaxed);
+    }
+
+    // Un trabajador por parte; el que empieza tarde encuentra la suya robada y sigue robando
+    lifeParallelFor(threads, [&](int self) {
+        LifeWorkQueue& own = lifeWorkQueues[self];
+        while (true) {
+            int span = takeLifeWork(own);
+            // Sin trabajo propio se busca en los demás hilos, empezando por el siguiente
+            for (int i = 1; span < 0 && i < threads; i++) {
+                span = stealLifeWork(lifeWorkQueues[(self + i) % threads], own);
+            }
+            if (span < 0) {
+                break;
+            }
+
+            const LifeWorkSpan& work = lifeWorkSpans[span];
+            int y0 = work.ty * LIFE_TILE_ROWS;
+            int y1 = min(y0 + LIFE_TILE_ROWS, universeHeight);
+            updateSpan(y0, y1, work.k0, work.k1, &lifeNextTileChanged[(size_t)work.ty * lifeTileCols]);
+        }
+    });
+}
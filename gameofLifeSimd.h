@@ -0,0 +1,196 @@
+// Kernels vectoriales para el Juego de la Vida.
+// Cada kernel calcula una fila completa del tablero de bits (con halo); la lógica de la
+// suma de vecinos es la misma de lifeWord(), aplicada a 2, 4 u 8 palabras de
+// 64 bits por instrucción (128, 256 o 512 células). Como el escalar, cada
+// kernel acumula en diff los bits que cambiaron y cuenta nacimientos y muertes
+// sobre los vectores que ya tiene en registros. El kernel se elige al
+// iniciar el programa según lo que reporta cpuid, y cada regla conocida
+// (ver gameofLifeRules.h) tiene su propia instancia de cada kernel.
+
+typedef void (*LifeRowKernel)(const uint64_t* above, const uint64_t* row, const uint64_t* below, uint64_t* out, uint64_t* diff, int words, uint64_t* changes);
+
+typedef uint64_t LifeVec128 __attribute__((vector_size(16)));
+typedef uint64_t LifeVec256 __attribute__((vector_size(32)));
+typedef uint64_t LifeVec512 __attribute__((vector_size(64)));
+
+template <typename V>
+LIFE_INLINE V lifeLoad(const uint64_t* p) {
+    V v;
+    memcpy(&v, p, sizeof(V));
+    return v;
+}
+
+// Cantidad de células vivas de cada byte de los vectores (de 0 a 8)
+template <typename V>
+LIFE_INLINE V lifeBytePopcount(const V& word) {
+    V v = word - ((word >> 1) & 0x5555555555555555ULL);
+    v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+    return (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+}
+
+// Suma los bytes de cada palabra de 64 bits
+template <typename V>
+LIFE_INLINE V lifeByteSum(const V& bytes) {
+    V v = (bytes & 0x00FF00FF00FF00FFULL) + ((bytes >> 8) & 0x00FF00FF00FF00FFULL);
+    v = (v & 0x0000FFFF0000FFFFULL) + ((v >> 16) & 0x0000FFFF0000FFFFULL);
+    return (v & 0xFFFFFFFFULL) + (v >> 32);
+}
+
+// Vectores que se pueden acumular por bytes antes de que alguno pase de 255
+const int LIFE_BYTE_COUNT_VECTORS = 31;
+
+// Cantidad de células vivas de cada palabra; con AVX-512 VPOPCNTDQ es una sola
+// instrucción (vpopcntq), en otro caso se parte en popcnt escalares
+template <typename V>
+LIFE_INLINE V lifeLanePopcount(const V& v) {
+    V count;
+    for (int i = 0; i < (int)(sizeof(V) / sizeof(uint64_t)); i++) {
+        count[i] = __builtin_popcountll(v[i]);
+    }
+    return count;
+}
+
+// Procesa la fila con vectores de V; las palabras que no llenan un vector
+// completo al final de la fila usan el camino escalar. LanePopcount cuenta
+// nacimientos y muertes con lifeLanePopcount en lugar de por bytes.
+template <typename V, int Birth, int Survive, bool LanePopcount = false>
+LIFE_INLINE void lifeRowVector(const uint64_t* above, const uint64_t* row, const uint64_t* below, uint64_t* out, uint64_t* diff, int words, uint64_t* changes) {
+    const int lanes = sizeof(V) / sizeof(uint64_t);
+    uint64_t births = 0, deaths = 0;
+
+    // Sin popcount vectorial, nacimientos y muertes se cuentan por bytes dentro de
+    // los vectores (popcount SWAR, sin sacar cada palabra a un registro escalar) y
+    // se suman por palabra cada LIFE_BYTE_COUNT_VECTORS vectores
+    V bornBytes = {}, diedBytes = {}, bornTotal = {}, diedTotal = {};
+    int pending = 0;
+
+    int k = 0;
+    for (; k + lanes <= words; k += lanes) {
+        // Las cargas desplazadas una palabra traen los bits que cruzan entre palabras;
+        // en los extremos de la fila leen las palabras de halo
+        V a = lifeLoad<V>(above + k), aPrev = lifeLoad<V>(above + k - 1), aNext = lifeLoad<V>(above + k + 1);
+        V b = lifeLoad<V>(row + k), bPrev = lifeLoad<V>(row + k - 1), bNext = lifeLoad<V>(row + k + 1);
+        V c = lifeLoad<V>(below + k), cPrev = lifeLoad<V>(below + k - 1), cNext = lifeLoad<V>(below + k + 1);
+
+        V next = lifeRuleWord<Birth, Survive, V>((a << 1) | (aPrev >> 63), a, (a >> 1) | (aNext << 63),
+                                                 (b << 1) | (bPrev >> 63), b, (b >> 1) | (bNext << 63),
+                                                 (c << 1) | (cPrev >> 63), c, (c >> 1) | (cNext << 63));
+        memcpy(out + k, &next, sizeof(V));
+
+        V changed = lifeLoad<V>(diff + k) | (next ^ b);
+        memcpy(diff + k, &changed, sizeof(V));
+
+        if (LanePopcount) {
+            bornTotal += lifeLanePopcount<V>(next & ~b);
+            diedTotal += lifeLanePopcount<V>(b & ~next);
+            continue;
+        }
+        bornBytes += lifeBytePopcount<V>(next & ~b);
+        diedBytes += lifeBytePopcount<V>(b & ~next);
+        if (++pending == LIFE_BYTE_COUNT_VECTORS) {
+            bornTotal += lifeByteSum<V>(bornBytes);
+            diedTotal += lifeByteSum<V>(diedBytes);
+            bornBytes = V{};
+            diedBytes = V{};
+            pending = 0;
+        }
+    }
+
+    if (k > 0) {
+        // Los tramos cortos (una o dos teselas) no llenan ningún vector
+        bornTotal += lifeByteSum<V>(bornBytes);
+        diedTotal += lifeByteSum<V>(diedBytes);
+        for (int i = 0; i < lanes; i++) {
+            births += bornTotal[i];
+            deaths += diedTotal[i];
+        }
+    }
+
+    for (; k < words; k++) {
+        out[k] = lifeRowWord<Birth, Survive>(above, row, below, k);
+        diff[k] |= out[k] ^ row[k];
+        lifeCountChanges(row[k], out[k], births, deaths);
+    }
+    changes[0] += births;
+    changes[1] += deaths;
+}
+
+// SSE2 forma parte de x86-64, así que es la base vectorial
+template <int Birth = LIFE_CONWAY_BIRTH, int Survive = LIFE_CONWAY_SURVIVE>
+void lifeRowSse2(const uint64_t* above, const uint64_t* row, const uint64_t* below, uint64_t* out, uint64_t* diff, int words, uint64_t* changes) {
+    lifeRowVector<LifeVec128, Birth, Survive>(above, row, below, out, diff, words, changes);
+}
+
+template <int Birth = LIFE_CONWAY_BIRTH, int Survive = LIFE_CONWAY_SURVIVE>
+__attribute__((target("avx2,popcnt")))
+void lifeRowAvx2(const uint64_t* above, const uint64_t* row, const uint64_t* below, uint64_t* out, uint64_t* diff, int words, uint64_t* changes) {
+    lifeRowVector<LifeVec256, Birth, Survive>(above, row, below, out, diff, words, changes);
+}
+
+template <int Birth = LIFE_CONWAY_BIRTH, int Survive = LIFE_CONWAY_SURVIVE>
+__attribute__((target("avx512f,popcnt")))
+void lifeRowAvx512(const uint64_t* above, const uint64_t* row, const uint64_t* below, uint64_t* out, uint64_t* diff, int words, uint64_t* changes) {
+    lifeRowVector<LifeVec512, Birth, Survive>(above, row, below, out, diff, words, changes);
+}
+
+template <int Birth = LIFE_CONWAY_BIRTH, int Survive = LIFE_CONWAY_SURVIVE>
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt")))
+void lifeRowAvx512Popcount(const uint64_t* above, const uint64_t* row, const uint64_t* below, uint64_t* out, uint64_t* diff, int words, uint64_t* changes) {
+    lifeRowVector<LifeVec512, Birth, Survive, true>(above, row, below, out, diff, words, changes);
+}
+
+// Juegos de instrucciones de los kernels, de menor a mayor ancho
+enum LifeKernelLevel {
+    LIFE_KERNEL_SCALAR,
+    LIFE_KERNEL_SSE2,
+    LIFE_KERNEL_AVX2,
+    LIFE_KERNEL_AVX512,
+    LIFE_KERNEL_AVX512_POPCOUNT  // AVX-512 con VPOPCNTDQ para contar nacimientos y muertes
+};
+
+const char* lifeKernelName = "scalar";
+
+// Elige el juego de instrucciones más ancho soportado por el procesador.
+// La variable de entorno LIFE_KERNEL (scalar, sse2, avx2, avx512) permite forzar uno.
+LifeKernelLevel selectLifeKernelLevel() {
+    __builtin_cpu_init();
+
+    const char* forced = getenv("LIFE_KERNEL");
+    string wanted = forced ? forced : "";
+
+    if (wanted == "scalar") {
+        lifeKernelName = "scalar";
+        return LIFE_KERNEL_SCALAR;
+    }
+    if ((wanted.empty() || wanted == "avx512") && __builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512vpopcntdq")) {
+        lifeKernelName = "avx512+vpopcntdq";
+        return LIFE_KERNEL_AVX512_POPCOUNT;
+    }
+    if ((wanted.empty() || wanted == "avx512") && __builtin_cpu_supports("avx512f")) {
+        lifeKernelName = "avx512";
+        return LIFE_KERNEL_AVX512;
+    }
+    if ((wanted.empty() || wanted == "avx512" || wanted == "avx2") && __builtin_cpu_supports("avx2")) {
+        lifeKernelName = "avx2";
+        return LIFE_KERNEL_AVX2;
+    }
+    lifeKernelName = "sse2";
+    return LIFE_KERNEL_SSE2;
+}
+
+LifeKernelLevel lifeKernelLevel = selectLifeKernelLevel();
+
+// Kernel de la regla B/S para el juego de instrucciones elegido
+template <int Birth = LIFE_CONWAY_BIRTH, int Survive = LIFE_CONWAY_SURVIVE>
+LifeRowKernel selectLifeRowKernel() {
+    switch (lifeKernelLevel) {
+        case LIFE_KERNEL_AVX512_POPCOUNT: return lifeRowAvx512Popcount<Birth, Survive>;
+        case LIFE_KERNEL_AVX512: return lifeRowAvx512<Birth, Survive>;
+        case LIFE_KERNEL_AVX2: return lifeRowAvx2<Birth, Survive>;
+        case LIFE_KERNEL_SSE2: return lifeRowSse2<Birth, Survive>;
+        default: return lifeRowScalar<Birth, Survive>;
+    }
+}
+
+LifeRowKernel lifeRowKernel = selectLifeRowKernel();
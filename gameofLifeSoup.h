@@ -0,0 +1,145 @@
+// Sopa aleatoria: llena el universo, o una región, con células vivas con una
+// probabilidad dada. Cada palabra de 64 células se arma con unas pocas palabras
+// aleatorias combinadas bit a bit según los bits de la densidad, de modo que
+// no hay una comparación por célula. Los números salen de ocho generadores
+// xoshiro256** por fila que avanzan juntos en vectores, con el mismo ancho de
+// los kernels (ver gameofLifeSimd.h). Se incluye desde gameofLife.h.
+
+// Densidad de la sopa inicial (--soup, 0 = sin sopa) y su región (--soup-region;
+// con ancho 0 es todo el universo)
+double lifeSoupDensity = 0;
+int lifeSoupX = 0;
+int lifeSoupY = 0;
+int lifeSoupWidth = 0;
+int lifeSoupHeight = 0;
+
+// Generadores por fila: la palabra k sale del generador k % LIFE_SOUP_LANES, así
+// que el resultado es el mismo con cualquier ancho de vector
+const int LIFE_SOUP_LANES = 8;
+// Bits de precisión de la densidad
+const int LIFE_SOUP_BITS = 16;
+// Flujo de lifeCounterRandom para las semillas de la sopa (los patrones usan 0 a 2)
+const uint64_t LIFE_SOUP_STREAM = 3;
+
+template <typename V>
+LIFE_INLINE V lifeSoupRotl(const V& x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// Un paso de xoshiro256** en todas las líneas de los vectores de s
+template <typename V>
+LIFE_INLINE V lifeSoupNext(V* s) {
+    V five = (s[1] << 2) + s[1];
+    V rotated = lifeSoupRotl(five, 7);
+    V result = (rotated << 3) + rotated;
+    V t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = lifeSoupRotl(s[3], 45);
+    return result;
+}
+
+// Llena out[0, words) (redondeado a LIFE_SOUP_LANES) con sopa de densidad
+// threshold / 2^LIFE_SOUP_BITS para la fila y. Empezando por el bit más bajo
+// de threshold, cada bit combina la palabra con una nueva: OR si vale 1 (la
+// probabilidad pasa a 1/2 + p/2) y AND si vale 0 (pasa a p/2).
+template <typename V>
+LIFE_INLINE void lifeSoupRowVector(uint64_t* out, int words, uint32_t threshold, uint64_t seed, int y) {
+    const int lanes = sizeof(V) / sizeof(uint64_t);
+    const int groups = LIFE_SOUP_LANES / lanes;
+
+    V state[groups][4];
+    for (int g = 0; g < groups; g++) {
+        for (int i = 0; i < 4; i++) {
+            uint64_t init[lanes];
+            for (int lane = 0; lane < lanes; lane++) {
+                init[lane] = lifeCounterRandom(seed, LIFE_SOUP_STREAM, ((uint64_t)y * LIFE_SOUP_LANES + g * lanes + lane) * 4 + i);
+            }
+            memcpy(&state[g][i], init, sizeof(V));
+        }
+    }
+
+    const int lowest = __builtin_ctz(threshold);
+    for (int k = 0; k < words; k += LIFE_SOUP_LANES) {
+        for (int g = 0; g < groups; g++) {
+            V soup = lifeSoupNext(state[g]);
+            for (int bit = lowest + 1; bit < LIFE_SOUP_BITS; bit++) {
+                V random = lifeSoupNext(state[g]);
+                soup = ((threshold >> bit) & 1) ? (soup | random) : (soup & random);
+            }
+            memcpy(out + k + g * lanes, &soup, sizeof(V));
+        }
+    }
+}
+
+typedef void (*LifeSoupRow)(uint64_t* out, int words, uint32_t threshold, uint64_t seed, int y);
+
+void lifeSoupRowScalar(uint64_t* out, int words, uint32_t threshold, uint64_t seed, int y) {
+    lifeSoupRowVector<uint64_t>(out, words, threshold, seed, y);
+}
+
+void lifeSoupRowSse2(uint64_t* out, int words, uint32_t threshold, uint64_t seed, int y) {
+    lifeSoupRowVector<LifeVec128>(out, words, threshold, seed, y);
+}
+
+__attribute__((target("avx2")))
+void lifeSoupRowAvx2(uint64_t* out, int words, uint32_t threshold, uint64_t seed, int y) {
+    lifeSoupRowVector<LifeVec256>(out, words, threshold, seed, y);
+}
+
+__attribute__((target("avx512f")))
+void lifeSoupRowAvx512(uint64_t* out, int words, uint32_t threshold, uint64_t seed, int y) {
+    lifeSoupRowVector<LifeVec512>(out, words, threshold, seed, y);
+}
+
+LifeSoupRow selectLifeSoupRow() {
+    switch (lifeKernelLevel) {
+        case LIFE_KERNEL_AVX512_POPCOUNT:
+        case LIFE_KERNEL_AVX512: return lifeSoupRowAvx512;
+        case LIFE_KERNEL_AVX2: return lifeSoupRowAvx2;
+        case LIFE_KERNEL_SSE2: return lifeSoupRowSse2;
+        default: return lifeSoupRowScalar;
+    }
+}
+
+// Reemplaza la región [x, x + width) x [y, y + height) (recortada al universo)
+// por sopa en la que cada célula está viva con probabilidad density. Cada fila
+// depende solo de lifeSeed, de su número y de x, así que se calculan en paralelo
+// y el resultado no depende de la cantidad de hilos.
+void fillLifeSoup(double density, int x, int y, int width, int height) {
+    int x0 = max(x, 0), x1 = min(x + width, universeWidth);
+    int y0 = max(y, 0), y1 = min(y + height, universeHeight);
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+
+    const int k0 = x0 / LIFE_WORD_BITS;
+    const int k1 = (x1 - 1) / LIFE_WORD_BITS;
+    const uint64_t firstMask = ~0ULL << (x0 % LIFE_WORD_BITS);
+    const uint64_t lastMask = ~0ULL >> (LIFE_WORD_BITS - 1 - (x1 - 1) % LIFE_WORD_BITS);
+    const uint32_t threshold = (uint32_t)llround(min(max(density, 0.0), 1.0) * (1 << LIFE_SOUP_BITS));
+    const int words = k1 - k0 + 1;
+    const LifeSoupRow soupRow = selectLifeSoupRow();
+
+    #pragma omp parallel for schedule(static)
+    for (int cellY = y0; cellY < y1; cellY++) {
+        thread_local vector<uint64_t> soup;
+        soup.resize((words + LIFE_SOUP_LANES - 1) / LIFE_SOUP_LANES * LIFE_SOUP_LANES);
+        if (threshold == 0 || threshold == (1u << LIFE_SOUP_BITS)) {
+            fill(soup.begin(), soup.end(), threshold ? ~0ULL : 0);
+        } else {
+            soupRow(soup.data(), words, threshold, lifeSeed ^ (uint64_t)x0 << 32, cellY);
+        }
+
+        uint64_t* row = lifeRow(lifeCells, cellY);
+        for (int k = k0; k <= k1; k++) {
+            uint64_t mask = (k == k0 ? firstMask : ~0ULL) & (k == k1 ? lastMask : ~0ULL);
+            row[k] = (row[k] & ~mask) | (soup[k - k0] & mask);
+        }
+    }
+
+    markAllLifeTilesChanged();
+}
@@ -0,0 +1,140 @@
+// Motor disperso: para universos casi vacíos guarda solo las células vivas en una
+// lista ordenada de coordenadas y calcula la siguiente generación a partir de ellas
+// y sus vecinas, así que el trabajo sigue a la población y no al área. Cuando la
+// población crece se pasa al tablero de bits, y vuelve a la lista cuando decae.
+// Como en HashLife, mientras la lista manda el tablero de bits no se actualiza.
+// Se incluye desde gameofLife.h.
+
+// Densidades para cambiar de representación: la lista se usa mientras haya menos
+// de una célula viva cada LIFE_SPARSE_ENTER células, y se deja con más de una
+// cada LIFE_SPARSE_LEAVE (la diferencia evita cambiar en cada generación)
+const uint64_t LIFE_SPARSE_ENTER = 8192;
+const uint64_t LIFE_SPARSE_LEAVE = 2048;
+// Cada cuántas generaciones el tablero de bits revisa si conviene volver a la lista
+const int LIFE_SPARSE_CHECK_INTERVAL = 32;
+
+// Célula viva como (y << 32) | x; ordenar las claves ordena por fila y luego columna
+vector<uint64_t> lifeSparseCells;
+vector<uint64_t> lifeSparseCandidates;
+bool lifeSparseMode = true;
+bool lifeSparseLoaded = false;
+
+inline uint64_t lifeSparseKey(int x, int y) {
+    return ((uint64_t)y << 32) | (uint32_t)x;
+}
+
+// ¿Hay pocas células vivas para el tamaño del universo?
+bool lifeSparseFits(uint64_t population, uint64_t threshold) {
+    return population * threshold < (uint64_t)universeWidth * universeHeight;
+}
+
+// Arma la lista con las células vivas del tablero de bits
+void lifeSparseImport() {
+    lifeSparseCells.clear();
+    for (int y = 0; y < universeHeight; y++) {
+        const uint64_t* row = lifeRow(lifeCells, y);
+        for (int k = 0; k < lifeWordsPerRow; k++) {
+            uint64_t word = row[k] & (k == lifeWordsPerRow - 1 ? lifeLastWordMask : ~0ULL);
+            while (word) {
+                lifeSparseCells.push_back(lifeSparseKey(k * LIFE_WORD_BITS + __builtin_ctzll(word), y));
+                word &= word - 1;
+            }
+        }
+    }
+
+    lifeSparseLoaded = true;
+    lifeGridEdited = false;
+}
+
+void lifeSparseExport() {
+    memset(lifeCells, 0, lifeWords * sizeof(uint64_t));
+    for (uint64_t key : lifeSparseCells) {
+        int x = (uint32_t)key;
+        int y = key >> 32;
+        lifeRow(lifeCells, y)[x / LIFE_WORD_BITS] |= 1ULL << (x % LIFE_WORD_BITS);
+    }
+
+    markAllLifeTilesChanged();
+    lifeGridEdited = false;
+}
+
+// Avanza una generación con la regla B/S activa. Cada célula viva aporta peso 2
+// a sus ocho vecinas y peso 1 a sí misma; al ordenar las claves, cada célula
+// candidata queda con 2 * vecinos + viva.
+void lifeSparseStep() {
+    bool wrap = lifeBoundary == LIFE_BOUNDARY_WRAP;
+
+    lifeSparseCandidates.clear();
+    lifeSparseCandidates.reserve(lifeSparseCells.size() * 9);
+    for (uint64_t key : lifeSparseCells) {
+        int x = (uint32_t)key;
+        int y = key >> 32;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int nx = x + dx;
+                int ny = y + dy;
+                if (wrap) {
+                    nx = (nx + universeWidth) % universeWidth;
+                    ny = (ny + universeHeight) % universeHeight;
+                } else if (nx < 0 || nx >= universeWidth || ny < 0 || ny >= universeHeight) {
+                    continue;
+                }
+                lifeSparseCandidates.push_back((lifeSparseKey(nx, ny) << 4) | ((dx || dy) ? 2 : 1));
+            }
+        }
+    }
+    sort(lifeSparseCandidates.begin(), lifeSparseCandidates.end());
+
+    lifeSparseCells.clear();
+    size_t i = 0;
+    while (i < lifeSparseCandidates.size()) {
+        uint64_t key = lifeSparseCandidates[i] >> 4;
+        int weight = 0;
+        for (; i < lifeSparseCandidates.size() && (lifeSparseCandidates[i] >> 4) == key; i++) {
+            weight += lifeSparseCandidates[i] & 15;
+        }
+        bool alive = weight & 1;
+        int mask = alive ? lifeRuleSurvive : lifeRuleBirth;
+        if ((mask >> (weight >> 1)) & 1) {
+            lifeSparseCells.push_back(key);
+            lifeBirths += !alive;
+        } else {
+            lifeDeaths += alive;
+        }
+    }
+}
+
+// Pinta la región visible recorriendo solo las células vivas de sus filas
+void lifeSparseColorize() {
+    fill(framebuffer, framebuffer + FRAMEBUFFER_SIZE, deadColor);
+
+    auto it = lower_bound(lifeSparseCells.begin(), lifeSparseCells.end(), lifeSparseKey(0, lifeViewY));
+    uint64_t end = lifeSparseKey(0, lifeViewY + RENDER_HEIGHT);
+    for (; it != lifeSparseCells.end() && *it < end; ++it) {
+        int x = (uint32_t)*it - lifeViewX;
+        int y = (int)(*it >> 32) - lifeViewY;
+        if (x >= 0 && x < RENDER_WIDTH) {
+            framebuffer[y * RENDER_WIDTH + x] = aliveColor;
+        }
+    }
+
+    lifeDirtyRect = { 0, 0, RENDER_WIDTH, RENDER_HEIGHT };
+}
+
+// Población del tablero de bits (para decidir si volver a la lista)
+uint64_t lifeGridPopulation() {
+    uint64_t population = 0;
+    lifeParallelFor(lifeTileRows, [&](int ty) {
+        uint64_t bandPopulation = 0;
+        int y1 = min((ty + 1) * LIFE_TILE_ROWS, universeHeight);
+        for (int y = ty * LIFE_TILE_ROWS; y < y1; y++) {
+            const uint64_t* row = lifeRow(lifeCells, y);
+            for (int k = 0; k < lifeWordsPerRow; k++) {
+                bandPopulation += __builtin_popcountll(row[k] & (k == lifeWordsPerRow - 1 ? lifeLastWordMask : ~0ULL));
+            }
+        }
+        #pragma omp atomic
+        population += bandPopulation;
+    });
+    return population;
+}
@@ -0,0 +1,377 @@
+// Motor de varios estados: reglas "Generations" (las células que mueren pasan por
+// estados intermedios antes de apagarse) y "Larger than Life" (vecindarios de radio
+// hasta LIFE_STATES_MAX_RADIUS). Cada célula ocupa un byte con su estado: 0 muerta,
+// 1 viva y de 2 a states - 1 muriendo. Los vecinos vivos se cuentan con una tabla
+// de sumas acumuladas (integral image), así que el costo por célula no depende del
+// radio. El estado vive aquí y se lleva al tablero de bits solo al cambiar de motor,
+// como en HashLife. Se incluye desde gameofLife.h.
+
+const int LIFE_STATES_MAX_RADIUS = 10;
+const int LIFE_STATES_MAX_STATES = 256;
+
+struct LifeStatesRule {
+    int radius;              // Radio del vecindario de Moore (1 = los ocho vecinos)
+    int states;              // Estados por célula (2 = regla binaria)
+    bool countMiddle;        // La propia célula cuenta como vecina (M1 en Larger than Life)
+    vector<uint8_t> birth;   // birth[n]: una célula muerta nace con n vecinos vivos
+    vector<uint8_t> survive; // survive[n]: una célula viva sigue viva con n vecinos vivos
+};
+
+// Regla binaria de radio 1 equivalente a unas máscaras B/S
+LifeStatesRule lifeStatesRuleFromMasks(int birth, int survive) {
+    LifeStatesRule rule = { 1, 2, false, vector<uint8_t>(9), vector<uint8_t>(9) };
+    for (int n = 0; n <= 8; n++) {
+        rule.birth[n] = (birth >> n) & 1;
+        rule.survive[n] = (survive >> n) & 1;
+    }
+    return rule;
+}
+
+LifeStatesRule lifeStatesRule = lifeStatesRuleFromMasks(LIFE_CONWAY_BIRTH, LIFE_CONWAY_SURVIVE);
+
+// Reglas con nombre propio
+const pair<const char*, const char*> lifeStatesRuleNames[] = {
+    { "brianbrain", "B2/S/C3" },
+    { "starwars", "345/2/4" },
+    { "bugs", "R5,C0,M1,S34..58,B34..45,NM" },
+    { "majority", "R4,C0,M1,S41..81,B41..81,NM" },
+    { "waffle", "R7,C0,M1,S100..200,B75..170,NM" },
+    { "globe", "R8,C0,M1,S163..223,B74..252,NM" }
+};
+
+// Lee un número entero sin signo desde text[pos], avanzando pos
+bool parseLifeStatesNumber(const string& text, size_t& pos, int& number) {
+    if (pos >= text.size() || !isdigit((unsigned char)text[pos])) {
+        return false;
+    }
+    number = 0;
+    while (pos < text.size() && isdigit((unsigned char)text[pos])) {
+        number = number * 10 + (text[pos++] - '0');
+        if (number > 1000000) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Larger than Life en la notación de Golly: "R5,C0,M1,S34..58,B34..45,NM"
+bool parseLargerThanLifeRule(const string& rule, LifeStatesRule& result) {
+    int radius = 1, states = 2, middle = 0;
+    int surviveMin = 0, surviveMax = -1, birthMin = 0, birthMax = -1;
+
+    size_t start = 0;
+    while (start <= rule.size()) {
+        size_t end = rule.find(',', start);
+        if (end == string::npos) {
+            end = rule.size();
+        }
+        string token = rule.substr(start, end - start);
+        start = end + 1;
+        if (token.empty()) {
+            return false;
+        }
+
+        size_t pos = 1;
+        char key = token[0];
+        if (key == 'n') {
+            // Solo el vecindario de Moore (cuadrado) se puede sumar con la tabla
+            if (token != "nm") {
+                return false;
+            }
+            continue;
+        }
+        if (key == 's' || key == 'b') {
+            int low, high;
+            if (!parseLifeStatesNumber(token, pos, low) || token.compare(pos, 2, "..") != 0) {
+                return false;
+            }
+            pos += 2;
+            if (!parseLifeStatesNumber(token, pos, high) || pos != token.size()) {
+                return false;
+            }
+            (key == 's' ? surviveMin : birthMin) = low;
+            (key == 's' ? surviveMax : birthMax) = high;
+            continue;
+        }
+
+        int value;
+        if (!parseLifeStatesNumber(token, pos, value) || pos != token.size()) {
+            return false;
+        }
+        if (key == 'r') {
+            radius = value;
+        } else if (key == 'c') {
+            states = value;
+        } else if (key == 'm') {
+            middle = value;
+        } else {
+            return false;
+        }
+    }
+
+    if (radius < 1 || radius > LIFE_STATES_MAX_RADIUS || states > LIFE_STATES_MAX_STATES || middle > 1) {
+        return false;
+    }
+
+    int maxCount = (2 * radius + 1) * (2 * radius + 1);
+    result = { radius, max(states, 2), middle == 1, vector<uint8_t>(maxCount + 1), vector<uint8_t>(maxCount + 1) };
+    for (int n = 0; n <= maxCount; n++) {
+        result.birth[n] = n >= birthMin && n <= birthMax;
+        result.survive[n] = n >= surviveMin && n <= surviveMax;
+    }
+    return true;
+}
+
+// Generations: "B2/S/C3" (en cualquier orden) o la notación clásica "345/2/4"
+// (supervivencia/nacimiento/estados)
+bool parseGenerationsRule(const string& rule, LifeStatesRule& result) {
+    vector<string> parts;
+    size_t start = 0;
+    while (true) {
+        size_t end = rule.find('/', start);
+        parts.push_back(rule.substr(start, end == string::npos ? string::npos : end - start));
+        if (end == string::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+    if (parts.size() != 3) {
+        return false;
+    }
+
+    string birthDigits, surviveDigits, statesDigits;
+    bool prefixed = false;
+    for (const string& part : parts) {
+        if (!part.empty() && (part[0] == 'b' || part[0] == 's' || part[0] == 'c' || part[0] == 'g')) {
+            prefixed = true;
+            string digits = part.substr(1);
+            (part[0] == 'b' ? birthDigits : part[0] == 's' ? surviveDigits : statesDigits) = digits;
+        }
+    }
+    if (!prefixed) {
+        surviveDigits = parts[0];
+        birthDigits = parts[1];
+        statesDigits = parts[2];
+    }
+
+    size_t pos = 0;
+    int states;
+    if (!parseLifeStatesNumber(statesDigits, pos, states) || pos != statesDigits.size() ||
+        states < 2 || states > LIFE_STATES_MAX_STATES) {
+        return false;
+    }
+
+    result = { 1, states, false, vector<uint8_t>(9), vector<uint8_t>(9) };
+    for (char digit : birthDigits) {
+        if (digit < '0' || digit > '8') {
+            return false;
+        }
+        result.birth[digit - '0'] = 1;
+    }
+    for (char digit : surviveDigits) {
+        if (digit < '0' || digit > '8') {
+            return false;
+        }
+        result.survive[digit - '0'] = 1;
+    }
+    return true;
+}
+
+// Lee una regla Generations o Larger than Life, o uno de sus nombres
+bool parseLifeStatesRule(const string& text, LifeStatesRule& result) {
+    string rule;
+    for (char ch : text) {
+        rule += (char)tolower((unsigned char)ch);
+    }
+
+    for (const auto& named : lifeStatesRuleNames) {
+        if (rule == named.first) {
+            return parseLifeStatesRule(named.second, result);
+        }
+    }
+
+    if (!rule.empty() && rule[0] == 'r') {
+        return parseLargerThanLifeRule(rule, result);
+    }
+    return parseGenerationsRule(rule, result);
+}
+
+vector<uint8_t> lifeStates;
+vector<uint8_t> lifeNextStates;
+vector<uint32_t> lifeStatesSums;
+bool lifeStatesLoaded = false;
+
+// Toma el tablero de bits como estado inicial. Las células vivas pasan a 1, las que
+// estaban vivas y ya no lo están se apagan, y las que estaban muriendo siguen igual.
+void lifeStatesImport() {
+    size_t cells = (size_t)universeWidth * universeHeight;
+    if (!lifeStatesLoaded || lifeStates.size() != cells) {
+        lifeStates.assign(cells, 0);
+        lifeNextStates.assign(cells, 0);
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < universeHeight; y++) {
+        uint8_t* states = &lifeStates[(size_t)y * universeWidth];
+        for (int x = 0; x < universeWidth; x++) {
+            if (getCell(x, y)) {
+                states[x] = 1;
+            } else if (states[x] == 1) {
+                states[x] = 0;
+            }
+        }
+    }
+
+    lifeStatesLoaded = true;
+    lifeGridEdited = false;
+}
+
+// Lleva las células vivas al tablero de bits (los estados intermedios cuentan como muertas)
+void lifeStatesExport() {
+    memset(lifeCells, 0, lifeWords * sizeof(uint64_t));
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < universeHeight; y++) {
+        const uint8_t* states = &lifeStates[(size_t)y * universeWidth];
+        uint64_t* row = lifeRow(lifeCells, y);
+        for (int x = 0; x < universeWidth; x++) {
+            row[x / LIFE_WORD_BITS] |= (uint64_t)(states[x] == 1) << (x % LIFE_WORD_BITS);
+        }
+    }
+
+    markAllLifeTilesChanged();
+    lifeGridEdited = false;
+}
+
+// Arma la tabla de sumas de células vivas sobre el universo extendido "radius"
+// células por lado (con copias del lado opuesto en un toro, o muertas si no).
+// La entrada (y + 1, x + 1) suma el rectángulo [0, x] x [0, y]; se usa aritmética
+// módulo 2^32, que da sumas de rectángulos exactas aunque el total se desborde.
+void buildLifeStatesSums(int radius) {
+    const int paddedWidth = universeWidth + 2 * radius;
+    const int paddedHeight = universeHeight + 2 * radius;
+    const size_t pitch = paddedWidth + 1;
+    bool wrap = lifeBoundary == LIFE_BOUNDARY_WRAP;
+
+    lifeStatesSums.resize(pitch * (paddedHeight + 1));
+    fill(lifeStatesSums.begin(), lifeStatesSums.begin() + pitch, 0);
+
+    // Sumas por fila, repartidas en bandas de LIFE_TILE_ROWS filas
+    lifeParallelFor((paddedHeight + LIFE_TILE_ROWS - 1) / LIFE_TILE_ROWS, [&](int band) {
+        int py1 = min(paddedHeight, (band + 1) * LIFE_TILE_ROWS);
+        for (int py = band * LIFE_TILE_ROWS; py < py1; py++) {
+            uint32_t* sums = &lifeStatesSums[(py + 1) * pitch];
+            sums[0] = 0;
+
+            int y = py - radius;
+            if (wrap) {
+                y = (y + universeHeight) % universeHeight;
+            } else if (y < 0 || y >= universeHeight) {
+                fill(sums + 1, sums + pitch, 0);
+                continue;
+            }
+
+            const uint8_t* states = &lifeStates[(size_t)y * universeWidth];
+            uint32_t running = 0;
+            for (int px = 0; px < paddedWidth; px++) {
+                int x = px - radius;
+                if (wrap) {
+                    x = (x + universeWidth) % universeWidth;
+                }
+                running += (x >= 0 && x < universeWidth && states[x] == 1);
+                sums[px + 1] = running;
+            }
+        }
+    });
+
+    // Acumulación vertical, por bloques de columnas para recorrer filas contiguas
+    const int columnBlock = 256;
+    lifeParallelFor(((int)pitch + columnBlock - 1) / columnBlock, [&](int block) {
+        int x0 = block * columnBlock;
+        int x1 = min((int)pitch, x0 + columnBlock);
+        for (int py = 1; py <= paddedHeight; py++) {
+            uint32_t* sums = &lifeStatesSums[py * pitch];
+            const uint32_t* above = sums - pitch;
+            for (int x = x0; x < x1; x++) {
+                sums[x] += above[x];
+            }
+        }
+    });
+}
+
+// Color de cada estado: las células que mueren se desvanecen de aliveColor a deadColor
+vector<Color> lifeStatesPalette() {
+    vector<Color> palette(lifeStatesRule.states);
+    palette[0] = deadColor;
+    for (int s = 1; s < lifeStatesRule.states; s++) {
+        int t = s - 1;
+        int steps = lifeStatesRule.states - 1;
+        palette[s] = { (uint8_t)(aliveColor.r + (deadColor.r - aliveColor.r) * t / steps),
+                       (uint8_t)(aliveColor.g + (deadColor.g - aliveColor.g) * t / steps),
+                       (uint8_t)(aliveColor.b + (deadColor.b - aliveColor.b) * t / steps) };
+    }
+    return palette;
+}
+
+void lifeStatesColorize() {
+    vector<Color> palette = lifeStatesPalette();
+
+    lifeParallelFor(RENDER_HEIGHT, [&](int y) {
+        Color* pixels = &framebuffer[y * RENDER_WIDTH];
+        int cellY = lifeViewY + y;
+        for (int x = 0; x < RENDER_WIDTH; x++) {
+            int cellX = lifeViewX + x;
+            bool inside = cellX < universeWidth && cellY < universeHeight;
+            pixels[x] = inside ? palette[lifeStates[(size_t)cellY * universeWidth + cellX]] : deadColor;
+        }
+    });
+
+    lifeDirtyRect = { 0, 0, RENDER_WIDTH, RENDER_HEIGHT };
+}
+
+// Avanza una generación con la regla de lifeStatesRule
+void lifeStatesStep() {
+    if (!lifeStatesLoaded || lifeGridEdited) {
+        lifeStatesImport();
+    }
+
+    const LifeStatesRule& rule = lifeStatesRule;
+    const int radius = rule.radius;
+    const int side = 2 * radius + 1;
+    const size_t pitch = universeWidth + 2 * radius + 1;
+    buildLifeStatesSums(radius);
+
+    // Filas en bandas de LIFE_TILE_ROWS; cada banda suma sus cambios a las estadísticas
+    lifeParallelFor(lifeTileRows, [&](int ty) {
+        uint64_t births = 0, deaths = 0;
+        int y1 = min((ty + 1) * LIFE_TILE_ROWS, universeHeight);
+        for (int y = ty * LIFE_TILE_ROWS; y < y1; y++) {
+            const uint8_t* states = &lifeStates[(size_t)y * universeWidth];
+            uint8_t* next = &lifeNextStates[(size_t)y * universeWidth];
+            // Filas de la tabla arriba y abajo del cuadrado centrado en la fila y
+            const uint32_t* top = &lifeStatesSums[y * pitch];
+            const uint32_t* bottom = &lifeStatesSums[(y + side) * pitch];
+
+            for (int x = 0; x < universeWidth; x++) {
+                uint8_t state = states[x];
+                int neighbors = bottom[x + side] - bottom[x] - top[x + side] + top[x];
+                if (!rule.countMiddle) {
+                    neighbors -= state == 1;
+                }
+
+                if (state == 0) {
+                    next[x] = rule.birth[neighbors];
+                } else if (state == 1) {
+                    next[x] = rule.survive[neighbors] ? 1 : (rule.states > 2 ? 2 : 0);
+                } else {
+                    next[x] = state + 1 < rule.states ? state + 1 : 0;
+                }
+                births += state == 0 && next[x] == 1;
+                deaths += state == 1 && next[x] != 1;
+            }
+        }
+        addLifeChanges(births, deaths);
+    });
+
+    lifeStates.swap(lifeNextStates);
+}
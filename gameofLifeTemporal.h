@@ -0,0 +1,177 @@
+// Bloqueo temporal para el tablero de bits: avanza lifeTemporalBlock generaciones
+// por llamada. Cada tramo de teselas activas de una banda de 64 filas se parte
+// en bloques de columnas; cada bloque se copia con un halo de k filas arriba y
+// abajo y una palabra a cada lado a un búfer local del hilo, se avanza k pasos
+// ahí mientras sigue en caché y solo entonces se escribe en el tablero. En cada
+// paso la región válida pierde una fila y una columna por lado, así que tras k
+// pasos (k <= 64) las 64 filas y las palabras propias del bloque son exactas.
+// Se incluye desde gameofLife.h.
+
+// Generaciones por cuadro del tablero de bits (1 = sin bloqueo temporal).
+// No puede pasar de LIFE_TILE_ROWS para que el halo no salga de las bandas vecinas.
+int lifeTemporalBlock = 1;
+
+// Tamaño de los dos búferes de un bloque juntos si el sistema no informa la L2
+const size_t LIFE_TEMPORAL_SCRATCH_BYTES = 256 * 1024;
+
+// Los búferes ocupan la mitad de la L2 de un núcleo; la otra mitad queda para
+// las filas del tablero que se leen y escriben. Un bloque de toda la fila no
+// entraría con universos anchos (a 65536 columnas y k = 64 serían 3 MB por hilo).
+inline size_t lifeTemporalScratchBytes() {
+    static const long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    return l2 > 0 ? (size_t)l2 / 2 : LIFE_TEMPORAL_SCRATCH_BYTES;
+}
+
+// Palabras de las filas de un bloque de cols palabras: el relleno de alineación,
+// las palabras de halo, y una palabra a cada lado que el kernel lee siempre en cero
+inline int lifeTemporalStride(int cols) {
+    return (LIFE_ROW_OFFSET + cols + 3 + LIFE_LINE_WORDS - 1) / LIFE_LINE_WORDS * LIFE_LINE_WORDS;
+}
+
+// Palabras propias de cada bloque para k generaciones, en múltiplos de una línea de caché
+inline int lifeTemporalBlockWords(int k) {
+    size_t rowBytes = 2 * (size_t)(LIFE_TILE_ROWS + 2 * k) * sizeof(uint64_t);
+    int words = (int)(lifeTemporalScratchBytes() / rowBytes) - (LIFE_ROW_OFFSET + 3);
+    return max(LIFE_LINE_WORDS, words / LIFE_LINE_WORDS * LIFE_LINE_WORDS);
+}
+
+// Las 64 células de la fila desde la columna x, que puede estar fuera del
+// universo: en un toro se toman del otro lado y si no son muertas
+inline uint64_t lifeCellWindow(const uint64_t* row, int x) {
+    if (x >= 0 && x + LIFE_WORD_BITS <= universeWidth) {
+        return row[x / LIFE_WORD_BITS];
+    }
+    bool wrap = lifeBoundary == LIFE_BOUNDARY_WRAP;
+    uint64_t word = 0;
+    for (int b = 0; b < LIFE_WORD_BITS; b++) {
+        int c = x + b;
+        if (wrap) {
+            c = ((c % universeWidth) + universeWidth) % universeWidth;
+        } else if (c < 0 || c >= universeWidth) {
+            continue;
+        }
+        word |= ((row[c / LIFE_WORD_BITS] >> (c % LIFE_WORD_BITS)) & 1) << b;
+    }
+    return word;
+}
+
+// Avanza k generaciones las palabras [k0, k1) de las filas [y0, y1) y marca las
+// teselas que cambiaron. La palabra j del bloque son las columnas desde
+// (k0 - 1 + j) * 64: la 0 y la k1 - k0 + 1 son el halo.
+void updateGameOfLifeTemporalBlock(int y0, int y1, int k0, int k1, uint8_t* changed) {
+    const int k = lifeTemporalBlock;
+    const int cols = k1 - k0 + 2;
+    const int stride = lifeTemporalStride(cols);
+    const int rows = (y1 - y0) + 2 * k;
+    const bool wrap = lifeBoundary == LIFE_BOUNDARY_WRAP;
+
+    // Sin toro, las columnas de fuera del universo se vuelven a matar en cada paso
+    const bool deadLeft = !wrap && k0 == 0;
+    const bool deadRight = !wrap && k1 == lifeWordsPerRow;
+
+    thread_local vector<uint64_t> blocks;
+    thread_local vector<uint64_t> diff;
+    thread_local vector<uint64_t> discard;
+    blocks.resize(2 * (size_t)rows * stride);
+    diff.assign(k1 - k0, 0);
+    discard.resize(cols);
+
+    // Los pasos intermedios no cuentan nacimientos ni muertes; se comparan solo
+    // el estado inicial y el final del bloque
+    uint64_t ignored[2] = { 0, 0 };
+    uint64_t births = 0, deaths = 0;
+
+    uint64_t* current = blocks.data();
+    uint64_t* next = current + (size_t)rows * stride;
+    auto blockRow = [&](uint64_t* block, int i) {
+        return block + (size_t)i * stride + LIFE_ROW_OFFSET;
+    };
+
+    // La fila i del bloque es la fila y0 - k + i del universo (módulo la altura en
+    // un toro); fuera del universo sin toro es una fila muerta que nunca cambia
+    auto universeRow = [&](int i) {
+        int y = y0 - k + i;
+        if (wrap) {
+            return ((y % universeHeight) + universeHeight) % universeHeight;
+        }
+        return (y >= 0 && y < universeHeight) ? y : -1;
+    };
+
+    for (int i = 0; i < rows; i++) {
+        uint64_t* row = blockRow(current, i);
+        uint64_t* out = blockRow(next, i);
+        row[-1] = row[cols] = out[-1] = out[cols] = 0;
+
+        int y = universeRow(i);
+        if (y < 0) {
+            memset(row, 0, cols * sizeof(uint64_t));
+            continue;
+        }
+        // Las palabras propias se copian tal cual salvo la última del universo,
+        // que junto con el halo puede tener columnas de fuera
+        const uint64_t* source = lifeRow(lifeCells, y);
+        memcpy(row + 1, source + k0, (k1 - k0) * sizeof(uint64_t));
+        row[0] = lifeCellWindow(source, (k0 - 1) * LIFE_WORD_BITS);
+        row[cols - 1] = lifeCellWindow(source, k1 * LIFE_WORD_BITS);
+        if (k1 == lifeWordsPerRow) {
+            row[cols - 2] = lifeCellWindow(source, (k1 - 1) * LIFE_WORD_BITS);
+        }
+    }
+
+    // Lo que el kernel calcula mal en los extremos (donde lee las palabras en
+    // cero) avanza una columna por paso, así que no pasa de las palabras de halo
+    for (int step = 1; step <= k; step++) {
+        for (int i = step; i < rows - step; i++) {
+            uint64_t* out = blockRow(next, i);
+            if (universeRow(i) < 0) {
+                memset(out, 0, cols * sizeof(uint64_t));
+                continue;
+            }
+            lifeRowKernel(blockRow(current, i - 1), blockRow(current, i), blockRow(current, i + 1),
+                          out, discard.data(), cols, ignored);
+            if (deadLeft) {
+                out[0] = 0;
+            }
+            if (deadRight) {
+                out[cols - 2] &= lifeLastWordMask;
+                out[cols - 1] = 0;
+            }
+        }
+        swap(current, next);
+    }
+
+    // Las diferencias se toman contra el estado de hace k generaciones
+    for (int y = y0; y < y1; y++) {
+        const uint64_t* row = blockRow(current, y - y0 + k) + 1;
+        const uint64_t* before = lifeRow(lifeCells, y);
+        uint64_t* out = lifeRow(lifeNextCells, y);
+        for (int w = k0; w < k1; w++) {
+            uint64_t mask = (w == lifeWordsPerRow - 1) ? lifeLastWordMask : ~0ULL;
+            uint64_t after = row[w - k0] & mask;
+            diff[w - k0] |= after ^ (before[w] & mask);
+            out[w] = after;
+            lifeCountChanges(before[w] & mask, after, births, deaths);
+        }
+    }
+    addLifeChanges(births, deaths);
+
+    for (int w = k0; w < k1; w++) {
+        changed[w] = diff[w - k0] != 0;
+    }
+}
+
+// Avanza k generaciones un tramo de teselas, en bloques que entran en la L2
+void updateGameOfLifeTemporalSpan(int y0, int y1, int k0, int k1, uint8_t* changed) {
+    const int words = lifeTemporalBlockWords(lifeTemporalBlock);
+    for (int w = k0; w < k1; w += words) {
+        updateGameOfLifeTemporalBlock(y0, y1, w, min(w + words, k1), changed);
+    }
+}
+
+// Avanza lifeTemporalBlock generaciones con el tablero de bits, con el mismo
+// reparto que el paso simple (incluido --scheduler steal). Un tramo cuyas
+// teselas y vecinas no cambiaron en el bloque anterior repite su estado (la
+// evolución es determinista), así que se salta igual que en el paso simple.
+void updateGameOfLifeTemporal() {
+    updateGameOfLifeGrid(updateGameOfLifeTemporalSpan);
+}
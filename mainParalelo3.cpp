@@ -136,8 +136,12 @@ void renderGIF(SDL_Renderer* renderer, const vector<SDL_Texture*>& gifTextures,
 }
 
 int main(int argc, char* argv[]) {
-    if (argc < 4) {
-        cerr << "Usage: " << argv[0] << " <max_gifs> <num_glider> <num_gun> <num_smallGlider>" << endl;
+    if (!parseLifeOptions(argc, argv)) {
+        return 1;
+    }
+
+    if (argc < 5) {
+        cerr << "Usage: " << argv[0] << " <max_gifs> <num_glider> <num_gun> <num_smallGlider> " << LIFE_OPTIONS_USAGE << endl;
         return 1;
     }
 
@@ -200,7 +204,7 @@ int main(int argc, char* argv[]) {
     }
 
     srand(time(nullptr));
-    initializeGameOfLife(num_glider, num_gun, num_small_glider);
+    if (!initializeGameOfLife(num_glider, num_gun, num_small_glider)) return 1;
 
     // Lista para almacenar todas las instancias de GIFs
     vector<GIFInstance> gifs;
@@ -299,9 +303,9 @@ int main(int argc, char* argv[]) {
             startTime = SDL_GetTicks();
             frameCount = 0;
 
-            // Actualiza el título de la ventana con los FPS
-            char title[50];
-            snprintf(title, sizeof(title), "[ScreenSaver - Parallel] - FPS: %.2f", fps);
+            // Actualiza el título de la ventana con los FPS y las estadísticas del universo
+            char title[192];
+            snprintf(title, sizeof(title), "[ScreenSaver - Parallel] - FPS: %.2f - %s", fps, formatLifeStats().c_str());
             SDL_SetWindowTitle(window, title);
         }
     }
@@ -309,6 +313,11 @@ int main(int argc, char* argv[]) {
     // Imprimir el tiempo total de ejecución al final
     cout << "Total Execution Time: " << totalExecutionTime << " ms" << endl;
 
+    // Con --checkpoint se guarda el universo al salir
+    if (!lifeCheckpointPath.empty()) {
+        saveLifeCheckpoint(lifeCheckpointPath);
+    }
+
     // Limpiar recursos
     for (auto texture : gifTextures) {
         SDL_DestroyTexture(texture);
@@ -36,8 +36,14 @@ SDL_AudioDeviceID audioDevice;
 
 SDL_Texture* gameOfLifeTexture = nullptr;
 
-void updateGameOfLifeTexture(SDL_Renderer* renderer) {
-    SDL_UpdateTexture(gameOfLifeTexture, NULL, framebuffer, RENDER_WIDTH * sizeof(Color));
+void updateGameOfLifeTexture(const LifeFrame& frame, uint64_t lastSequence) {
+    // Si es el cuadro siguiente al último que se subió, basta con la región que
+    // cambió; si se saltearon cuadros, se sube entero
+    SDL_Rect rect = (frame.sequence == lastSequence + 1) ? frame.dirty : SDL_Rect{ 0, 0, RENDER_WIDTH, RENDER_HEIGHT };
+    if (rect.w > 0) {
+        const Color* pixels = &frame.pixels[rect.y * RENDER_WIDTH + rect.x];
+        SDL_UpdateTexture(gameOfLifeTexture, &rect, pixels, RENDER_WIDTH * sizeof(Color));
+    }
 }
 
 void setWindowIcon(SDL_Window* window, const char* iconPath) {
@@ -139,8 +145,12 @@ void renderGIF(SDL_Renderer* renderer, const vector<SDL_Texture*>& gifTextures,
 
 
 int main(int argc, char* argv[]) {
-    if (argc < 4) {
-        cerr << "Usage: " << argv[0] << " <max_gifs> <num_glider> <num_gun> <num_smallGlider>" << endl;
+    if (!parseLifeOptions(argc, argv)) {
+        return 1;
+    }
+
+    if (argc < 5) {
+        cerr << "Usage: " << argv[0] << " <max_gifs> <num_glider> <num_gun> <num_smallGlider> " << LIFE_OPTIONS_USAGE << endl;
         return 1;
     }
 
@@ -192,11 +202,16 @@ int main(int argc, char* argv[]) {
 
     gifs.push_back({100.0f, 100.0f, 5.0f, 5.0f, false});
 
-    // Inicializar Game of Life
-    initializeGameOfLife(num_glider, num_gun, num_small_glider);
+    // Inicializar Game of Life (con --restore también vuelven los sprites guardados)
+    if (!initializeGameOfLife(num_glider, num_gun, num_small_glider)) {
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        return 1;
+    }
+    takeLifeCheckpointSprites(gifs, max_gifs);
 
     // Crear textura para el Game of Life
-    gameOfLifeTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, RENDER_WIDTH, RENDER_HEIGHT);
+    gameOfLifeTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGB24, SDL_TEXTUREACCESS_STREAMING, RENDER_WIDTH, RENDER_HEIGHT);
     if (!gameOfLifeTexture) {
         cerr << "Failed to create Game of Life texture! SDL Error: " << SDL_GetError() << endl;
         // Manejar el error apropiadamente
@@ -209,20 +224,25 @@ int main(int argc, char* argv[]) {
     int frameTime;
     Uint32 totalExecutionTime = 0;
 
+    // La simulación corre en su propio hilo (ver gameofLifeFrames.h); este
+    // atiende los eventos, mueve los GIFs y dibuja la última generación publicada
+    startLifeSimulation();
+    uint64_t lastSequence = 0;
+    LifeStats lifeStats = {};
+
     while (running) {
         frameStart = SDL_GetTicks();
-        
+
         while (SDL_PollEvent(&e) != 0) {
             if (e.type == SDL_QUIT) {
                 running = false;
             }
         }
 
-        // Añadir nuevos GIFs si un GIF rebota
+        // Añadir nuevos GIFs si un GIF rebota (como mucho uno por cuadro)
         bool gifAdded = false;
-
-        #pragma omp parallel for schedule(dynamic)
-        for (size_t i = 0; i < gifs.size(); ++i) {
+        size_t gifCount = gifs.size();
+        for (size_t i = 0; i < gifCount; ++i) {
             gifs[i].posX += gifs[i].velX;
             gifs[i].posY += gifs[i].velY;
 
@@ -238,28 +258,26 @@ int main(int argc, char* argv[]) {
                 rebote = true;
             }
 
-            // Si hubo rebote y no se ha añadido un GIF en este ciclo, añadir uno nuevo
             if (rebote && !gifAdded && gifs.size() < max_gifs) {
-                #pragma omp critical
-                {
-                    if (!gifAdded) { // Reconfirmamos dentro de la sección crítica
-                        float newPosX = static_cast<float>(rand() % (WIDTH - 120));
-                        float newPosY = static_cast<float>(rand() % (HEIGHT - 30));
-                        float newVelX = static_cast<float>((rand() % 7 + 1) * (rand() % 2 == 0 ? 1 : -1));
-                        float newVelY = static_cast<float>((rand() % 7 + 1) * (rand() % 2 == 0 ? 1 : -1));
-                        gifs.push_back({newPosX, newPosY, newVelX, newVelY, newVelX < 0});
-                        gifAdded = true; // Evitar añadir más de un GIF en este ciclo
-                    }
-                }
+                float newPosX = static_cast<float>(lifeRandom() % (WIDTH - 120));
+                float newPosY = static_cast<float>(lifeRandom() % (HEIGHT - 30));
+                float newVelX = static_cast<float>((lifeRandom() % 7 + 1) * (lifeRandom() % 2 == 0 ? 1 : -1));
+                float newVelY = static_cast<float>((lifeRandom() % 7 + 1) * (lifeRandom() % 2 == 0 ? 1 : -1));
+                gifs.push_back({newPosX, newPosY, newVelX, newVelY, newVelX < 0});
+                gifAdded = true;
             }
-}
+        }
 
-        updateGameOfLife();
-        updateGameOfLifeTexture(renderer);
+        // Sin generación nueva se vuelve a mostrar la textura como estaba
+        if (const LifeFrame* frame = takeLifeFrame()) {
+            updateGameOfLifeTexture(*frame, lastSequence);
+            lastSequence = frame->sequence;
+            lifeStats = frame->stats;
+        }
 
         SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF);
         SDL_RenderClear(renderer);
-        
+
         // Renderizar Game of Life
         SDL_RenderCopy(renderer, gameOfLifeTexture, NULL, NULL);
 
@@ -283,14 +301,22 @@ int main(int argc, char* argv[]) {
             startTime = SDL_GetTicks();
             frameCount = 0;
 
-            char title[50];
-            snprintf(title, sizeof(title), "[ScreenSaver - Parallel] - FPS: %.2f", fps);
+            char title[224];
+            snprintf(title, sizeof(title), "[ScreenSaver - Parallel] - FPS: %.2f - Gen: %llu - %s", fps,
+                     (unsigned long long)lifeStats.generation, formatLifeStats(lifeStats).c_str());
             SDL_SetWindowTitle(window, title);
         }
     }
 
+    // El checkpoint se guarda con el tablero quieto
+    stopLifeSimulation();
+
     cout << "Total Execution Time: " << totalExecutionTime << " ms" << endl;
 
+    if (!lifeCheckpointPath.empty()) {
+        saveLifeCheckpoint(lifeCheckpointPath, gifs.data(), sizeof(GIFInstance), gifs.size());
+    }
+
     // Limpiar recursos
     for (auto texture : gifTextures) {
         SDL_DestroyTexture(texture);